@@ -14,6 +14,7 @@
 #include <FredEmmott/GUI/Immediate/FontIcon.hpp>
 #include <FredEmmott/GUI/Immediate/GPUTexture.hpp>
 #include <FredEmmott/GUI/Immediate/HyperlinkButton.hpp>
+#include <FredEmmott/GUI/Immediate/ItemsRepeater.hpp>
 #include <FredEmmott/GUI/Immediate/Label.hpp>
 #include <FredEmmott/GUI/Immediate/MenuFlyout.hpp>
 #include <FredEmmott/GUI/Immediate/NavigationView.hpp>
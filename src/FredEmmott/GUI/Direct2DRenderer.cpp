@@ -8,11 +8,13 @@
 #include <FredEmmott/GUI/Brush.hpp>
 #include <FredEmmott/GUI/Color.hpp>
 #include <FredEmmott/GUI/Font.hpp>
+#include <FredEmmott/GUI/FrameProfiler.hpp>
 #include <FredEmmott/GUI/Rect.hpp>
 #include <FredEmmott/GUI/SoftwareBitmap.hpp>
 #include <felly/overload.hpp>
 #include <felly/scope_exit.hpp>
 #include <numbers>
+#include <stdexcept>
 
 #include "CornerRadius.hpp"
 #include "assert.hpp"
@@ -93,12 +95,57 @@ void Direct2DRenderer::PopLayer() {
 }
 
 void Direct2DRenderer::PushClipRect(const Rect& rect) {
+  mClipStack.push(
+    this->GetDeviceClipBounds().GetIntersection(this->GetDeviceBounds(rect)));
   mDeviceResources.mD2DDeviceContext->PushAxisAlignedClip(
     rect, D2D1_ANTIALIAS_MODE_ALIASED);
 }
 
 void Direct2DRenderer::PopClipRect() {
   mDeviceResources.mD2DDeviceContext->PopAxisAlignedClip();
+  mClipStack.pop();
+}
+
+Rect Direct2DRenderer::GetDeviceClipBounds() const {
+  if (!mClipStack.empty()) {
+    return mClipStack.top();
+  }
+  const auto [width, height] = mDeviceResources.mD2DDeviceContext->GetSize();
+  return Rect {Size {width, height}};
+}
+
+bool Direct2DRenderer::QuickReject(const Rect& rect) const {
+  return !this->GetDeviceClipBounds().Intersects(this->GetDeviceBounds(rect));
+}
+
+std::unique_ptr<PaintRecording> Direct2DRenderer::EndRecording() {
+  throw std::logic_error("Direct2DRenderer does not support recording");
+}
+
+void Direct2DRenderer::DrawRecording(const PaintRecording&) {
+  throw std::logic_error("Direct2DRenderer does not support recording");
+}
+
+Rect Direct2DRenderer::GetDeviceBounds(const Rect& rect) const {
+  D2D1::Matrix3x2F transform {};
+  mDeviceResources.mD2DDeviceContext->GetTransform(&transform);
+
+  Point topLeft {
+    std::numeric_limits<float>::infinity(),
+    std::numeric_limits<float>::infinity(),
+  };
+  Point bottomRight = -topLeft;
+  for (auto&& corner: {
+         rect.GetTopLeft(),
+         rect.GetTopRight(),
+         rect.GetBottomRight(),
+         rect.GetBottomLeft(),
+       }) {
+    const auto [x, y] = transform.TransformPoint(corner.as<D2D1_POINT_2F>());
+    topLeft = {std::min(topLeft.mX, x), std::min(topLeft.mY, y)};
+    bottomRight = {std::max(bottomRight.mX, x), std::max(bottomRight.mY, y)};
+  }
+  return {topLeft, bottomRight};
 }
 
 void Direct2DRenderer::Scale(float x, float y) {
@@ -125,6 +172,7 @@ void Direct2DRenderer::Rotate(const float degrees, const Point& center) {
 }
 
 void Direct2DRenderer::FillRect(const Brush& brush, const Rect& rect) {
+  FrameProfiler::CountDrawCall();
   mDeviceResources.mD2DDeviceContext->FillRectangle(
     rect, brush.as<ID2D1Brush*>(this, rect));
 }
@@ -133,6 +181,7 @@ void Direct2DRenderer::StrokeRect(
   const Brush& brush,
   const Rect& rect,
   const float thickness) {
+  FrameProfiler::CountDrawCall();
   mDeviceResources.mD2DDeviceContext->DrawRectangle(
     rect,
     brush.as<ID2D1Brush*>(this, rect),
@@ -145,6 +194,7 @@ void Direct2DRenderer::DrawLine(
   const Point& end,
   const float thickness,
   const StrokeCap strokeCap) {
+  FrameProfiler::CountDrawCall();
   mDeviceResources.mD2DDeviceContext->DrawLine(
     start.as<D2D1_POINT_2F>(),
     end.as<D2D1_POINT_2F>(),
@@ -157,6 +207,7 @@ void Direct2DRenderer::FillRoundedRect(
   const Brush& brush,
   const Rect& rect,
   const CornerRadius& radii) {
+  FrameProfiler::CountDrawCall();
   if (radii.IsUniform()) {
     const auto radius = radii.GetUniformValue();
     mDeviceResources.mD2DDeviceContext->FillRoundedRectangle(
@@ -175,6 +226,7 @@ void Direct2DRenderer::StrokeRoundedRect(
   const CornerRadius& radii,
   const EdgeFlags edges,
   const float thickness) {
+  FrameProfiler::CountDrawCall();
   FUI_ASSERT(
     edges != EdgeFlags::None,
     "Should never call StrokeRoundedRect if there's nothing to do");
@@ -200,6 +252,7 @@ void Direct2DRenderer::StrokeArc(
   const float sweepAngle,
   const float thickness,
   const StrokeCap strokeCap) {
+  FrameProfiler::CountDrawCall();
   if (
     strokeCap == StrokeCap::None
     && std::abs(sweepAngle) < std::numeric_limits<float>::epsilon()) {
@@ -250,6 +303,7 @@ void Direct2DRenderer::StrokeEllipse(
   const Brush& brush,
   const Rect& rect,
   const float thickness) {
+  FrameProfiler::CountDrawCall();
   constexpr auto Epsilon = std::numeric_limits<float>::epsilon();
   if (
     rect.GetWidth() < Epsilon || rect.GetHeight() < Epsilon
@@ -272,6 +326,7 @@ void Direct2DRenderer::DrawText(
   const Font& font,
   std::string_view text,
   const Point& baseline) {
+  FrameProfiler::CountDrawCall();
   if (text.empty()) {
     return;
   }
@@ -290,6 +345,24 @@ void Direct2DRenderer::DrawText(
     DWRITE_MEASURING_MODE_NATURAL);
 }
 
+void Direct2DRenderer::DrawShapedText(
+  const Brush& brush,
+  const Rect& brushRect,
+  const ShapedText& text,
+  const Point& baseline) {
+  FrameProfiler::CountDrawCall();
+  const auto layout = text.as<wil::com_ptr<IDWriteTextLayout>>().get();
+  if (!layout) {
+    return;
+  }
+  // Same origin as `DrawText()`
+  mDeviceResources.mD2DDeviceContext->DrawTextLayout(
+    baseline.as<D2D1_POINT_2F>(),
+    layout,
+    brush.as<ID2D1Brush*>(this, brushRect),
+    D2D1_DRAW_TEXT_OPTIONS_ENABLE_COLOR_FONT);
+}
+
 std::unique_ptr<ImportedTexture> Direct2DRenderer::ImportTexture(
   const ImportedTexture::HandleKind kind,
   HANDLE const handle) const {
@@ -363,6 +436,7 @@ void Direct2DRenderer::DrawTexture(
   ImportedTexture* const rawTexture,
   ImportedFence* const rawFence,
   uint64_t fenceValue) {
+  FrameProfiler::CountDrawCall();
 #ifdef FUI_DEBUG
 #define IMPL_CAST dynamic_cast
 #else
@@ -550,6 +624,7 @@ wil::com_ptr<ID2D1PathGeometry> Direct2DRenderer::MakeRoundedRectPathGeometry(
 }
 
 void Direct2DRenderer::Clear(const Color& color) {
+  FrameProfiler::CountDrawCall();
   mDeviceResources.mD2DDeviceContext->Clear(color.as<D2D1_COLOR_F>());
 }
 
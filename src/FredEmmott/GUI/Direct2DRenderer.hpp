@@ -46,6 +46,21 @@ class Direct2DRenderer final : public Renderer {
   void Clear(const Color& color) override;
   void PushClipRect(const Rect& rect) override;
   void PopClipRect() override;
+  [[nodiscard]]
+  Rect GetDeviceClipBounds() const override;
+  [[nodiscard]]
+  bool QuickReject(const Rect& rect) const override;
+  [[nodiscard]]
+  Rect GetDeviceBounds(const Rect& rect) const override;
+
+  // Not currently supported; `ID2D1CommandList` would be the natural fit
+  [[nodiscard]]
+  bool BeginRecording(const Rect&) override {
+    return false;
+  }
+  [[nodiscard]]
+  std::unique_ptr<PaintRecording> EndRecording() override;
+  void DrawRecording(const PaintRecording&) override;
 
   // Transformations
   void Scale(float x, float y) override;
@@ -93,6 +108,11 @@ class Direct2DRenderer final : public Renderer {
     const Font& font,
     std::string_view text,
     const Point& baseline) override;
+  void DrawShapedText(
+    const Brush& brush,
+    const Rect& brushRect,
+    const ShapedText& text,
+    const Point& baseline) override;
 
   [[nodiscard]]
   std::unique_ptr<ImportedTexture> ImportTexture(
@@ -140,6 +160,9 @@ class Direct2DRenderer final : public Renderer {
   DeviceResources mDeviceResources {};
   std::shared_ptr<GPUCompletionFlag> mFrameCompletionFlag;
   std::stack<StateStackFrame> mStateStack;
+  // Direct2D doesn't let us query the axis-aligned clip, so track it
+  // ourselves, in device space
+  std::stack<Rect> mClipStack;
 
   void PostTransform(const D2D1_MATRIX_3X2_F&);
 
@@ -2,6 +2,11 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
 #include <variant>
 
 #include "Interpolation/CubicBezier.hpp"
@@ -29,6 +34,16 @@ struct Linear {
   }
 };
 
+/** A CSS-style `cubic-bezier(x1, y1, x2, y2)` easing function.
+ *
+ * The input is the x coordinate, so we need to solve x(t) = x, then return
+ * y(t).
+ *
+ * A table of t for evenly-spaced x is built by the constructor; when the
+ * control points are constants, this happens at compile time. Evaluating
+ * looks up the initial guess in constant time, then refines it with Newton's
+ * method, which usually only needs one or two iterations from there.
+ */
 struct CubicBezier {
   CubicBezier() = delete;
   constexpr CubicBezier(float x1, float y1, float x2, float y2)
@@ -46,64 +61,47 @@ struct CubicBezier {
   }
 
   constexpr float operator()(const float x) const {
-    if (!mSamples) {
-      // mutable in `const` method as it's a cache
-      mSamples = CreateSamples(mX1, mX2);
+    // P0 is (0, 0) and P3 is (1, 1)
+    if (x <= 0) {
+      return 0;
     }
-
-    // Find t for x
-    float low = 0;
-    float high = 1;
-    if (x < mSamples->front().mX) {
-      high = mSamples->front().mT;
-    } else if (x > mSamples->back().mX) {
-      low = mSamples->back().mT;
-    } else {
-      uint8_t lowIdx = 0;
-      uint8_t highIdx = static_cast<uint8_t>(std::size(*mSamples) - 1);
-      while (lowIdx < highIdx) {
-        uint8_t mid = (highIdx + lowIdx) / 2;
-        const auto& sample = mSamples->at(mid);
-        if (x < sample.mX) {
-          highIdx = mid;
-          high = sample.mT;
-        } else {
-          lowIdx = mid + 1;
-          low = sample.mT;
-        }
-      }
+    if (x >= 1) {
+      return 1;
     }
 
-    float t = (high + low) / 2;
-    auto [approximateX, slope] = GetXValueAndSlope(t);
-    for (uint8_t i = 0; i < 8 && std::abs(x - approximateX) > XAccuracy; ++i) {
-      if (x > approximateX) {
-        low = t;
-      } else {
-        high = t;
-      }
-      if (slope < 1e-6) {
-        // Binary search
-        t = (high + low) / 2;
-      } else {
-        // Newton's method
-        t -= (approximateX - x) / slope;
-      }
-      std::tie(approximateX, slope) = GetXValueAndSlope(t);
-    }
+    const auto position = x * (SampleCount - 1);
+    const auto index
+      = std::min(static_cast<std::size_t>(position), SampleCount - 2);
+    const auto fraction = position - static_cast<float>(index);
+    const auto low = mSamples[index];
+    const auto high = mSamples[index + 1];
 
-    // Calculate y given t
+    const auto t
+      = SolveT(x, low + ((high - low) * fraction), low, high, MaxIterations);
     return GetYValue_ILoveWin32(t);
   }
 
-  constexpr bool operator==(const CubicBezier&) const noexcept = default;
+  constexpr bool operator==(const CubicBezier& other) const noexcept {
+    // Everything else is derived from the control points
+    return mX1 == other.mX1 && mY1 == other.mY1 && mX2 == other.mX2
+      && mY2 == other.mY2;
+  }
 
  private:
-  constexpr void Initialize() {
-    if consteval {
-      mSamples.emplace(CreateSamples(mX1, mX2));
-    }
+  static constexpr float XAccuracy = 1e-6;
+  // With 16 samples, the initial guess is usually within 1e-3 of the result
+  static constexpr std::size_t SampleCount = 16;
+  static constexpr uint8_t MaxIterations = 8;
+  // The table is built without an initial guess, so needs more iterations
+  static constexpr uint8_t MaxTableIterations = 32;
 
+  float mX1, mY1, mX2, mY2;
+  float mXC1, mXC2, mXC3;
+  float mYC1, mYC2, mYC3;
+  // `mSamples[i]` is t where x(t) = i / (SampleCount - 1)
+  std::array<float, SampleCount> mSamples {};
+
+  constexpr void Initialize() {
     const auto v3x1 = 3 * mX1;
     const auto v3x2 = 3 * mX2;
     const auto v6x1 = 6 * mX1;
@@ -118,34 +116,43 @@ struct CubicBezier {
     mYC1 = 1 - v3y2 + v3y1;
     mYC2 = v3y2 - v6y1;
     mYC3 = v3y1;
-  }
 
-  static constexpr float XAccuracy = 1e-6;
-  // as 1 / 11 == 0.09, which is < 0.1, this means we will always have a
-  // looked-up (t, x) tuple with x within 0.1 of the desired x
-  static constexpr size_t SampleCount = 11;
-  struct Sample {
-    float mT {};
-    float mX {};
-    constexpr bool operator==(const Sample&) const noexcept = default;
-  };
-  using Samples = std::array<Sample, SampleCount>;
-  mutable std::optional<Samples> mSamples {};
-
-  float mX1, mY1, mX2, mY2;
-  float mXC1, mXC2, mXC3;
-  float mYC1, mYC2, mYC3;
+    mSamples.front() = 0;
+    mSamples.back() = 1;
+    for (std::size_t i = 1; i < SampleCount - 1; ++i) {
+      const auto x = static_cast<float>(i) / (SampleCount - 1);
+      mSamples[i] = SolveT(x, x, 0, 1, MaxTableIterations);
+    }
+  }
 
-  static constexpr Samples CreateSamples(const float x1, const float x2) {
-    Samples samples;
-    for (std::ptrdiff_t i = 0; i < SampleCount; ++i) {
-      const auto t = (i + 1.f) / (SampleCount + 1);
-      samples[i] = {
-        .mT = t,
-        .mX = Interpolation::CubicBezier(x1, x2, t),
-      };
+  /** Find t where x(t) = x.
+   *
+   * `low` and `high` must bracket the result; as x(t) is monotonic for valid
+   * CSS curves, this is any pair of t values where x(low) <= x <= x(high).
+   */
+  constexpr float SolveT(
+    const float x,
+    float t,
+    float low,
+    float high,
+    const uint8_t maxIterations) const {
+    for (uint8_t i = 0; i < maxIterations; ++i) {
+      const auto [approximateX, slope] = GetXValueAndSlope(t);
+      const auto error = approximateX - x;
+      // Not `std::abs()`, as it is not `constexpr` in MSVC's STL
+      if ((error < 0 ? -error : error) <= XAccuracy) {
+        return t;
+      }
+      if (error > 0) {
+        high = t;
+      } else {
+        low = t;
+      }
+      // Newton's method, unless it would leave the bracket; then, bisect
+      const auto next = (slope > 1e-6f) ? (t - (error / slope)) : low;
+      t = (next > low && next < high) ? next : ((low + high) / 2);
     }
-    return samples;
+    return t;
   }
 
   // Horner method to calculate both at the same time, using pre-computed
@@ -154,7 +154,24 @@ void FocusManager::FocusPreviousWidget() {
   FocusLastWidget();
 }
 
+void FocusManager::MarkFocusChangesStyleDirty() {
+  const auto focus = this->GetFocusedWidget();
+  if (focus == mStyledFocus) {
+    return;
+  }
+  if (mStyledFocus) {
+    get<0>(*mStyledFocus)->MarkStyleDirty();
+  }
+  if (focus) {
+    get<0>(*focus)->MarkStyleDirty();
+  }
+  mStyledFocus = focus;
+}
+
 void FocusManager::BeforeDestroy(Widgets::Widget* widget) {
+  if (mStyledFocus && get<0>(*mStyledFocus) == widget) {
+    mStyledFocus.reset();
+  }
   if (mFocusedWidget != widget) {
     return;
   }
@@ -62,6 +62,13 @@ class FocusManager final {
 
   void BeforeDestroy(Widgets::Widget*);
 
+  /** Mark widgets that gained or lost focus since the last call as needing
+   * their styles recomputed.
+   *
+   * Should be called before `Widget::ComputeStyles()`.
+   */
+  void MarkFocusChangesStyleDirty();
+
   [[nodiscard]]
   bool OnKeyPress(const KeyPressEvent& e);
 
@@ -70,6 +77,9 @@ class FocusManager final {
   Widgets::Widget* mFocusedWidget {};
   FocusKind mFocusKind {FocusKind::Implicit};
 
+  // As of the last call to `MarkFocusChangesStyleDirty()`
+  std::optional<std::tuple<Widgets::Widget*, FocusKind>> mStyledFocus;
+
   void FocusFirstWidget();
   void FocusLastWidget();
 
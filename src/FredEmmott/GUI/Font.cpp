@@ -4,6 +4,7 @@
 #include "Font.hpp"
 
 #include "Immediate/TextBlock.hpp"
+#include "ShapedText.hpp"
 #include "assert.hpp"
 #include "detail/font_detail.hpp"
 #include "detail/renderer_detail.hpp"
@@ -132,4 +133,13 @@ float Font::MeasureTextWidth(const std::string_view text) const noexcept {
     *this, text);
 }
 
+std::vector<float> Font::MeasureTextOffsets(const std::string_view text) const {
+  return renderer_detail::GetFontMetricsProvider()->MeasureTextOffsets(
+    *this, text);
+}
+
+ShapedText Font::ShapeText(const std::string_view text) const {
+  return renderer_detail::GetFontMetricsProvider()->ShapeText(*this, text);
+}
+
 }// namespace FredEmmott::GUI
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <optional>
 #include <string_view>
 #include <variant>
+#include <vector>
 
 #include "FontWeight.hpp"
 #include "SystemFont.hpp"
@@ -18,6 +19,7 @@
 #endif
 
 namespace FredEmmott::GUI {
+class ShapedText;
 
 namespace detail {
 template <class T>
@@ -70,6 +72,24 @@ class Font {
   [[nodiscard]]
   float MeasureTextWidth(std::string_view) const noexcept;
 
+  /** The x offset of the caret before each byte of the text.
+   *
+   * This lays out the text once, so is linear in the length of the text,
+   * rather than calling `MeasureTextWidth()` for every prefix.
+   *
+   * The result has `text.size() + 1` elements, and the last is the total
+   * width. Elements for bytes that do not start a code point are NaN.
+   */
+  [[nodiscard]]
+  std::vector<float> MeasureTextOffsets(std::string_view) const;
+
+  /** Shape the text once, for repeated drawing.
+   *
+   * Requires `ShapedText.hpp`.
+   */
+  [[nodiscard]]
+  ShapedText ShapeText(std::string_view) const;
+
   template <native_font T>
   T as() const {
     return std::get<T>(mFont);
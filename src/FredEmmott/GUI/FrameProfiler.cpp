@@ -0,0 +1,356 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#include "FrameProfiler.hpp"
+
+#include <FredEmmott/GUI/Widgets/Widget.hpp>
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <ranges>
+
+#include "Color.hpp"
+#include "Renderer.hpp"
+#include "assert.hpp"
+
+namespace FredEmmott::GUI {
+
+thread_local FrameProfiler* FrameProfiler::tCurrent {nullptr};
+thread_local const Widgets::Widget* FrameProfiler::tCurrentWidget {nullptr};
+
+namespace {
+
+constexpr Rect OverlayRect {Point {8, 8}, Size {240, 64}};
+constexpr float OverlayBarWidth = 2;
+// Frames taking this long or longer fill the overlay
+constexpr auto OverlayFullScale = std::chrono::milliseconds(33);
+constexpr auto OverlayTargetFrameTime = std::chrono::microseconds(16'667);
+
+constexpr auto OverlayBackgroundColor
+  = Color::Constant::FromRGBA32(0, 0, 0, 0xc0);
+constexpr auto OverlayTargetColor
+  = Color::Constant::FromRGBA32(0xff, 0xff, 0xff, 0x80);
+constexpr std::array OverlayPhaseColors {
+  Color::Constant::FromRGBA32(0x80, 0x80, 0x80, 0xff),// ProcessNativeEvents
+  Color::Constant::FromRGBA32(0x4c, 0xaf, 0x50, 0xff),// UserCallback
+  Color::Constant::FromRGBA32(0xff, 0xc1, 0x07, 0xff),// Reconcile
+  Color::Constant::FromRGBA32(0x21, 0x96, 0xf3, 0xff),// Layout
+  Color::Constant::FromRGBA32(0x9c, 0x27, 0xb0, 0xff),// Tick
+  Color::Constant::FromRGBA32(0xf4, 0x43, 0x36, 0xff),// Paint
+  Color::Constant::FromRGBA32(0x00, 0xbc, 0xd4, 0xff),// Present
+};
+static_assert(OverlayPhaseColors.size() == FramePhaseCount);
+
+void AppendJSONString(std::string& out, const std::string_view value) {
+  out += '"';
+  for (const auto c: value) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          std::format_to(
+            std::back_inserter(out), "\\u{:04x}", static_cast<int>(c));
+        } else {
+          out += c;
+        }
+        break;
+    }
+  }
+  out += '"';
+}
+
+auto ToMicroseconds(const FrameProfile::clock::duration d) {
+  return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(
+           d)
+    .count();
+}
+
+}// namespace
+
+std::string_view GetName(const FramePhase phase) noexcept {
+  switch (phase) {
+    case FramePhase::ProcessNativeEvents:
+      return "ProcessNativeEvents";
+    case FramePhase::UserCallback:
+      return "UserCallback";
+    case FramePhase::Reconcile:
+      return "Reconcile";
+    case FramePhase::Layout:
+      return "Layout";
+    case FramePhase::Tick:
+      return "Tick";
+    case FramePhase::Paint:
+      return "Paint";
+    case FramePhase::Present:
+      return "Present";
+  }
+  std::unreachable();
+}
+
+std::string_view GetName(const WidgetCounter counter) noexcept {
+  switch (counter) {
+    case WidgetCounter::StylesRecomputed:
+      return "StylesRecomputed";
+    case WidgetCounter::YogaNodesDirtied:
+      return "YogaNodesDirtied";
+    case WidgetCounter::ParagraphsRebuilt:
+      return "ParagraphsRebuilt";
+    case WidgetCounter::DrawCalls:
+      return "DrawCalls";
+    case WidgetCounter::StyleCacheMisses:
+      return "StyleCacheMisses";
+  }
+  std::unreachable();
+}
+
+FrameProfiler::FrameProfiler(const std::size_t capacity) : mFrames(capacity) {
+  FUI_ASSERT(capacity > 0);
+}
+
+FrameProfiler::~FrameProfiler() {
+  // e.g. an exception was thrown by the user callback
+  this->CancelFrame();
+}
+
+void FrameProfiler::SetIsEnabled(const bool value) {
+  if (value == mIsEnabled) {
+    return;
+  }
+  mIsEnabled = value;
+  if (!value) {
+    this->CancelFrame();
+  }
+}
+
+void FrameProfiler::SetIsOverlayVisible(const bool value) noexcept {
+  mIsOverlayVisible = value;
+}
+
+std::vector<FrameProfile> FrameProfiler::GetFrames() const {
+  std::vector<FrameProfile> ret;
+  ret.reserve(mFrameCount);
+  const auto first
+    = (mNextFrame + mFrames.size() - mFrameCount) % mFrames.size();
+  for (std::size_t i = 0; i < mFrameCount; ++i) {
+    ret.push_back(mFrames[(first + i) % mFrames.size()]);
+  }
+  return ret;
+}
+
+const FrameProfile* FrameProfiler::GetLatestFrame() const noexcept {
+  if (mFrameCount == 0) {
+    return nullptr;
+  }
+  return &mFrames[(mNextFrame + mFrames.size() - 1) % mFrames.size()];
+}
+
+void FrameProfiler::Clear() {
+  mFrameCount = 0;
+  mNextFrame = 0;
+}
+
+void FrameProfiler::BeginFrame() {
+  FUI_ASSERT(!mCurrentFrame, "Nested frames for the same profiler");
+  if (!mIsEnabled) {
+    return;
+  }
+  auto& frame = mFrames[mNextFrame];
+  frame.mFrameNumber = mFrameNumber++;
+  frame.mBegin = clock::now();
+  frame.mEnd = {};
+  frame.mPhases = {};
+  // Keep the capacity, to avoid allocating each frame
+  frame.mWidgetCounters.clear();
+
+  mCurrentFrame = &frame;
+  mPreviousProfiler = std::exchange(tCurrent, this);
+}
+
+void FrameProfiler::EndFrame() {
+  if (!mCurrentFrame) {
+    return;
+  }
+  mCurrentFrame->mEnd = clock::now();
+  mCurrentFrame = nullptr;
+  tCurrent = std::exchange(mPreviousProfiler, nullptr);
+
+  mNextFrame = (mNextFrame + 1) % mFrames.size();
+  mFrameCount = std::min(mFrameCount + 1, mFrames.size());
+}
+
+void FrameProfiler::CancelFrame() {
+  if (!mCurrentFrame) {
+    return;
+  }
+  mCurrentFrame = nullptr;
+  tCurrent = std::exchange(mPreviousProfiler, nullptr);
+}
+
+void FrameProfiler::BeginPhase(const FramePhase phase) {
+  if (!mCurrentFrame) {
+    return;
+  }
+  const auto now = clock::now();
+  auto& record = mCurrentFrame->mPhases[std::to_underlying(phase)];
+  if (record.mBegin == clock::time_point {}) {
+    record.mBegin = now;
+  }
+  mPhaseStarts[std::to_underlying(phase)] = now;
+}
+
+void FrameProfiler::EndPhase(const FramePhase phase) {
+  if (!mCurrentFrame) {
+    return;
+  }
+  const auto start = mPhaseStarts[std::to_underlying(phase)];
+  if (start == clock::time_point {}) {
+    return;
+  }
+  mCurrentFrame->mPhases[std::to_underlying(phase)].mDuration
+    += clock::now() - start;
+  mPhaseStarts[std::to_underlying(phase)] = {};
+}
+
+void FrameProfiler::Increment(
+  const WidgetCounter counter,
+  const Widgets::Widget* widget) {
+  if (!(mCurrentFrame && widget)) {
+    return;
+  }
+  const auto key = widget->GetPrimaryStyleClass();
+  auto& counters = mCurrentFrame->mWidgetCounters;
+  // There are few enough widget types that a linear search is cheaper than
+  // hashing
+  auto it = std::ranges::find(counters, key, [](const auto& pair) {
+    return pair.first;
+  });
+  if (it == counters.end()) {
+    counters.emplace_back(key, FrameProfile::Counters {});
+    it = std::prev(counters.end());
+  }
+  ++it->second[std::to_underlying(counter)];
+}
+
+std::string FrameProfiler::ExportChromeTrace() const {
+  const auto frames = this->GetFrames();
+  std::string out;
+  out += R"({"displayTimeUnit":"ms","traceEvents":[)";
+  if (frames.empty()) {
+    out += "]}";
+    return out;
+  }
+
+  const auto epoch = frames.front().mBegin;
+  bool first = true;
+  const auto beginEvent = [&]() {
+    if (!std::exchange(first, false)) {
+      out += ',';
+    }
+  };
+
+  for (auto&& frame: frames) {
+    beginEvent();
+    std::format_to(
+      std::back_inserter(out),
+      R"({{"name":"Frame {}","cat":"frame","ph":"X","pid":1,"tid":1,)"
+      R"("ts":{:.3f},"dur":{:.3f}}})",
+      frame.mFrameNumber,
+      ToMicroseconds(frame.mBegin - epoch),
+      ToMicroseconds(frame.mEnd - frame.mBegin));
+
+    for (std::size_t i = 0; i < FramePhaseCount; ++i) {
+      const auto& phase = frame.mPhases[i];
+      if (phase.mBegin == FrameProfile::clock::time_point {}) {
+        continue;
+      }
+      beginEvent();
+      out += R"({"name":)";
+      AppendJSONString(out, GetName(static_cast<FramePhase>(i)));
+      std::format_to(
+        std::back_inserter(out),
+        R"(,"cat":"phase","ph":"X","pid":1,"tid":1,)"
+        R"("ts":{:.3f},"dur":{:.3f}}})",
+        ToMicroseconds(phase.mBegin - epoch),
+        ToMicroseconds(phase.mDuration));
+    }
+
+    for (std::size_t i = 0; i < WidgetCounterCount; ++i) {
+      beginEvent();
+      out += R"({"name":)";
+      AppendJSONString(out, GetName(static_cast<WidgetCounter>(i)));
+      std::format_to(
+        std::back_inserter(out),
+        R"(,"cat":"counters","ph":"C","pid":1,"ts":{:.3f},"args":{{)",
+        ToMicroseconds(frame.mBegin - epoch));
+      bool firstArg = true;
+      for (auto&& [widgetClass, counters]: frame.mWidgetCounters) {
+        if (!std::exchange(firstArg, false)) {
+          out += ',';
+        }
+        AppendJSONString(out, widgetClass.GetName());
+        std::format_to(std::back_inserter(out), ":{}", counters[i]);
+      }
+      out += "}}";
+    }
+  }
+  out += "]}";
+  return out;
+}
+
+Rect FrameProfiler::GetOverlayRect() noexcept {
+  return OverlayRect;
+}
+
+void FrameProfiler::PaintOverlay(Renderer* renderer) const {
+  renderer->FillRect(OverlayBackgroundColor, OverlayRect);
+
+  const auto barCount = static_cast<std::size_t>(
+    OverlayRect.GetWidth() / OverlayBarWidth);
+  const auto frameCount = std::min(barCount, mFrameCount);
+  const auto first
+    = (mNextFrame + mFrames.size() - frameCount) % mFrames.size();
+
+  const auto height = OverlayRect.GetHeight();
+  const auto toHeight = [height](const FrameProfile::clock::duration d) {
+    return std::min(
+      height,
+      height
+        * std::chrono::duration<float>(d).count()
+        / std::chrono::duration<float>(OverlayFullScale).count());
+  };
+
+  for (std::size_t i = 0; i < frameCount; ++i) {
+    const auto& frame = mFrames[(first + i) % mFrames.size()];
+    const auto left = OverlayRect.GetLeft() + (i * OverlayBarWidth);
+    auto bottom = OverlayRect.GetBottom();
+    for (std::size_t phase = 0; phase < FramePhaseCount; ++phase) {
+      const auto barHeight = std::min(
+        toHeight(frame.mPhases[phase].mDuration),
+        bottom - OverlayRect.GetTop());
+      if (barHeight <= 0) {
+        continue;
+      }
+      renderer->FillRect(
+        OverlayPhaseColors[phase],
+        Rect {
+          Point {left, bottom - barHeight},
+          Size {OverlayBarWidth, barHeight},
+        });
+      bottom -= barHeight;
+    }
+  }
+
+  const auto targetY
+    = OverlayRect.GetBottom() - toHeight(OverlayTargetFrameTime);
+  renderer->DrawLine(
+    OverlayTargetColor,
+    Point {OverlayRect.GetLeft(), targetY},
+    Point {OverlayRect.GetRight(), targetY},
+    1);
+}
+
+}// namespace FredEmmott::GUI
@@ -0,0 +1,205 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Rect.hpp"
+#include "StyleClass.hpp"
+
+namespace FredEmmott::GUI::Widgets {
+class Widget;
+}// namespace FredEmmott::GUI::Widgets
+
+namespace FredEmmott::GUI {
+
+class Renderer;
+
+enum class FramePhase : uint8_t {
+  ProcessNativeEvents,
+  // Between `Window::BeginFrame()` and `Window::EndFrame()`
+  UserCallback,
+  // `Root::EndFrame()`: widget tree reconciliation, and `ComputeStyles()`
+  Reconcile,
+  Layout,
+  Tick,
+  Paint,
+  Present,
+};
+constexpr std::size_t FramePhaseCount
+  = std::to_underlying(FramePhase::Present) + 1;
+
+[[nodiscard]]
+std::string_view GetName(FramePhase) noexcept;
+
+enum class WidgetCounter : uint8_t {
+  StylesRecomputed,
+  YogaNodesDirtied,
+  ParagraphsRebuilt,
+  DrawCalls,
+  StyleCacheMisses,
+};
+constexpr std::size_t WidgetCounterCount
+  = std::to_underlying(WidgetCounter::StyleCacheMisses) + 1;
+
+[[nodiscard]]
+std::string_view GetName(WidgetCounter) noexcept;
+
+struct FrameProfile {
+  using clock = std::chrono::steady_clock;
+  struct Phase {
+    clock::time_point mBegin {};
+    // Sum of all spans of this phase in the frame
+    clock::duration mDuration {};
+  };
+  using Counters = std::array<uint32_t, WidgetCounterCount>;
+
+  uint64_t mFrameNumber {};
+  clock::time_point mBegin {};
+  clock::time_point mEnd {};
+  std::array<Phase, FramePhaseCount> mPhases {};
+  // Keyed by the widget's primary style class
+  std::vector<std::pair<StyleClass, Counters>> mWidgetCounters;
+};
+
+/** Per-window record of where frame time goes.
+ *
+ * This is disabled by default; when disabled, the instrumentation points
+ * cost a thread-local read each. The most recent frames are kept in a ring
+ * buffer, which can be exported as Chrome trace JSON, e.g. for
+ * `chrome://tracing` or https://ui.perfetto.dev
+ */
+class FrameProfiler {
+ public:
+  using clock = FrameProfile::clock;
+  static constexpr std::size_t DefaultCapacity = 300;
+
+  explicit FrameProfiler(std::size_t capacity = DefaultCapacity);
+  ~FrameProfiler();
+
+  FrameProfiler(const FrameProfiler&) = delete;
+  FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+  void SetIsEnabled(bool);
+  [[nodiscard]]
+  bool IsEnabled() const noexcept {
+    return mIsEnabled;
+  }
+
+  /// Show a frame time graph in the top-left of the window
+  void SetIsOverlayVisible(bool) noexcept;
+  [[nodiscard]]
+  bool IsOverlayVisible() const noexcept {
+    return mIsOverlayVisible;
+  }
+
+  /// Completed frames, oldest first
+  [[nodiscard]]
+  std::vector<FrameProfile> GetFrames() const;
+  /// The most recently completed frame, or nullptr
+  [[nodiscard]]
+  const FrameProfile* GetLatestFrame() const noexcept;
+  void Clear();
+
+  [[nodiscard]]
+  std::string ExportChromeTrace() const;
+
+  /// Overlay area, in canvas coordinates
+  [[nodiscard]]
+  static Rect GetOverlayRect() noexcept;
+  void PaintOverlay(Renderer*) const;
+
+  void BeginFrame();
+  void EndFrame();
+  /// Discard the current frame, e.g. if the window is closing
+  void CancelFrame();
+
+  void BeginPhase(FramePhase);
+  void EndPhase(FramePhase);
+
+  class ScopedPhase {
+   public:
+    ScopedPhase() = delete;
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    explicit ScopedPhase(const FramePhase phase) noexcept
+      : mProfiler(tCurrent),
+        mPhase(phase) {
+      if (mProfiler) [[unlikely]] {
+        mProfiler->BeginPhase(phase);
+      }
+    }
+
+    ~ScopedPhase() {
+      if (mProfiler) [[unlikely]] {
+        mProfiler->EndPhase(mPhase);
+      }
+    }
+
+   private:
+    FrameProfiler* mProfiler {nullptr};
+    FramePhase mPhase {};
+  };
+
+  /// Attribute draw calls to `widget` for the lifetime of this object
+  class ScopedWidget {
+   public:
+    ScopedWidget() = delete;
+    ScopedWidget(const ScopedWidget&) = delete;
+    ScopedWidget& operator=(const ScopedWidget&) = delete;
+
+    explicit ScopedWidget(const Widgets::Widget* widget) noexcept
+      : mPrevious(std::exchange(tCurrentWidget, widget)) {}
+
+    ~ScopedWidget() {
+      tCurrentWidget = mPrevious;
+    }
+
+   private:
+    const Widgets::Widget* mPrevious {nullptr};
+  };
+
+  static void Count(
+    const WidgetCounter counter,
+    const Widgets::Widget* widget) {
+    if (tCurrent) [[unlikely]] {
+      tCurrent->Increment(counter, widget);
+    }
+  }
+
+  /// Count a draw call for the current `ScopedWidget`, if any
+  static void CountDrawCall() {
+    if (tCurrent && tCurrentWidget) [[unlikely]] {
+      tCurrent->Increment(WidgetCounter::DrawCalls, tCurrentWidget);
+    }
+  }
+
+ private:
+  // The profiler for the frame in progress on this thread, if it is enabled
+  static thread_local FrameProfiler* tCurrent;
+  static thread_local const Widgets::Widget* tCurrentWidget;
+
+  bool mIsEnabled {false};
+  bool mIsOverlayVisible {false};
+
+  std::vector<FrameProfile> mFrames;
+  // Index of the next frame to write in `mFrames`
+  std::size_t mNextFrame {};
+  std::size_t mFrameCount {};
+  uint64_t mFrameNumber {};
+
+  FrameProfile* mCurrentFrame {nullptr};
+  FrameProfiler* mPreviousProfiler {nullptr};
+  std::array<clock::time_point, FramePhaseCount> mPhaseStarts {};
+
+  void Increment(WidgetCounter, const Widgets::Widget*);
+};
+
+}// namespace FredEmmott::GUI
@@ -0,0 +1,101 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include "FrameScheduler.hpp"
+
+#include <utility>
+
+#include "Widgets/Widget.hpp"
+#include "assert.hpp"
+
+namespace FredEmmott::GUI {
+
+FrameScheduler::~FrameScheduler() = default;
+
+void FrameScheduler::Invalidate(Widgets::Widget* const widget) {
+  FUI_ASSERT(widget);
+  mPending.insert(widget);
+  if (mParent) {
+    mParent->Invalidate(mOwner);
+  }
+}
+
+void FrameScheduler::BeforeDestroy(Widgets::Widget* const widget) {
+  mPending.erase(widget);
+  mCurrentWakeups.erase(widget);
+}
+
+void FrameScheduler::SetParent(
+  FrameScheduler* const parent,
+  Widgets::Widget* const owner) {
+  FUI_ASSERT((parent == nullptr) == (owner == nullptr));
+  mParent = parent;
+  mOwner = owner;
+}
+
+bool FrameScheduler::IsCurrent(const Wakeup& wakeup) const {
+  const auto it = mCurrentWakeups.find(wakeup.mWidget);
+  return it != mCurrentWakeups.end()
+    && it->second.mGeneration == wakeup.mGeneration;
+}
+
+void FrameScheduler::SetWakeup(
+  Widgets::Widget* const widget,
+  const std::optional<clock::time_point> at) {
+  if (!at) {
+    mCurrentWakeups.erase(widget);
+    return;
+  }
+
+  const auto it = mCurrentWakeups.find(widget);
+  if (it != mCurrentWakeups.end() && it->second.mAt == *at) {
+    // Avoid growing the queue with stale entries for widgets that are queried
+    // every frame
+    return;
+  }
+
+  const auto generation = mNextGeneration++;
+  mCurrentWakeups.insert_or_assign(widget, CurrentWakeup {*at, generation});
+  mWakeups.push({*at, widget, generation});
+}
+
+FrameRateRequirement FrameScheduler::GetFrameRateRequirement(
+  const clock::time_point now) {
+  while (!mWakeups.empty() && mWakeups.top().mAt <= now) {
+    const auto wakeup = mWakeups.top();
+    mWakeups.pop();
+    if (IsCurrent(wakeup)) {
+      mCurrentWakeups.erase(wakeup.mWidget);
+      mPending.insert(wakeup.mWidget);
+    }
+  }
+
+  std::vector<FrameRateRequirement> ret;
+  for (auto it = mPending.begin(); it != mPending.end();) {
+    const auto widget = *it;
+    auto requirement = widget->GetFrameRateRequirement();
+    this->SetWakeup(widget, requirement.GetAfter());
+
+    // These can't be represented by a wake-up time, so we need to keep
+    // asking
+    if (
+      requirement.RequiresSmoothAnimation()
+      || !requirement.GetNativeWaitables().empty()) {
+      ret.push_back(std::move(requirement));
+      ++it;
+      continue;
+    }
+    it = mPending.erase(it);
+  }
+
+  while (!(mWakeups.empty() || IsCurrent(mWakeups.top()))) {
+    mWakeups.pop();
+  }
+  if (!mWakeups.empty()) {
+    ret.emplace_back(FrameRateRequirement::After {mWakeups.top().mAt});
+  }
+
+  return FrameRateRequirement {ret};
+}
+
+}// namespace FredEmmott::GUI
@@ -0,0 +1,91 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "FrameRateRequirement.hpp"
+
+namespace FredEmmott::GUI::Widgets {
+class Widget;
+}// namespace FredEmmott::GUI::Widgets
+
+namespace FredEmmott::GUI {
+
+/** Per-window record of which widgets need future frames.
+ *
+ * Widgets call `Widget::InvalidateFrameRateRequirement()` when their
+ * `GetFrameRateRequirement()` may have changed, e.g. when an animation
+ * starts; only those widgets are queried, rather than the entire tree.
+ *
+ * - widgets that require smooth animation or native waitables are queried
+ *   again each frame, until they no longer do
+ * - widgets that require a frame after a specific time are queried again once
+ *   that time has passed; these are kept in a priority queue, so finding the
+ *   next wake-up does not depend on the number of widgets
+ */
+class FrameScheduler final {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  FrameScheduler() = default;
+  ~FrameScheduler();
+
+  FrameScheduler(const FrameScheduler&) = delete;
+  FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+  void Invalidate(Widgets::Widget*);
+  void BeforeDestroy(Widgets::Widget*);
+
+  /** Also invalidate `owner` in `parent` when a widget is invalidated.
+   *
+   * This is for popup windows, which are only updated as part of their owner
+   * window's frame.
+   */
+  void SetParent(FrameScheduler* parent, Widgets::Widget* owner);
+
+  [[nodiscard]]
+  FrameRateRequirement GetFrameRateRequirement(clock::time_point now);
+
+ private:
+  struct Wakeup {
+    clock::time_point mAt {};
+    Widgets::Widget* mWidget {nullptr};
+    uint64_t mGeneration {};
+
+    bool operator>(const Wakeup& other) const noexcept {
+      return mAt > other.mAt;
+    }
+  };
+  struct CurrentWakeup {
+    clock::time_point mAt {};
+    uint64_t mGeneration {};
+  };
+
+  // Widgets to query in the next `GetFrameRateRequirement()`
+  std::unordered_set<Widgets::Widget*> mPending;
+
+  // Entries are not removed from `mWakeups` when they are replaced or the
+  // widget is destroyed; they are stale unless they match `mCurrentWakeups`
+  std::priority_queue<Wakeup, std::vector<Wakeup>, std::greater<>> mWakeups;
+  std::unordered_map<Widgets::Widget*, CurrentWakeup> mCurrentWakeups;
+  // Never reused, so a new widget at the address of a destroyed one can not
+  // match the destroyed widget's stale entries
+  uint64_t mNextGeneration {};
+
+  FrameScheduler* mParent {nullptr};
+  Widgets::Widget* mOwner {nullptr};
+
+  [[nodiscard]]
+  bool IsCurrent(const Wakeup&) const;
+  void SetWakeup(Widgets::Widget*, std::optional<clock::time_point>);
+};
+
+}// namespace FredEmmott::GUI
@@ -8,6 +8,7 @@
 #include <wil/resource.h>
 
 #include <array>
+#include <bit>
 #include <felly/numeric_cast.hpp>
 #include <felly/overload.hpp>
 #include <span>
@@ -0,0 +1,49 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include "ItemsRepeater.hpp"
+
+namespace FredEmmott::GUI::Immediate::immediate_detail {
+
+namespace {
+constexpr LiteralStyleClass ItemStyleClass {"ItemsRepeater/Item"};
+}
+
+Widgets::ItemsRepeater::RealizedRange BeginItemsRepeater(
+  const std::size_t itemCount,
+  const ItemSizing sizing,
+  const float itemHeight,
+  const ID id) {
+  const auto repeater = BeginWidget<Widgets::ItemsRepeater>(id);
+  const auto ret = repeater->Update(itemCount, sizing, itemHeight);
+  if (repeater->NeedsAdditionalFrame()) {
+    // We guessed; try again once we have a layout
+    tNeedAdditionalFrame = true;
+  }
+  return ret;
+}
+
+void EndItemsRepeater() {
+  EndWidget<Widgets::ItemsRepeater>();
+}
+
+void BeginItemsRepeaterItem(const std::size_t index) {
+  using Widgets::ItemsRepeater;
+  const auto repeater = GetCurrentParentNode<ItemsRepeater>();
+  FUI_ASSERT(repeater, "Items must be direct children of an ItemsRepeater");
+
+  static const ImmutableStyle BaseStyle {
+    Style().FlexDirection(FlexDirection::Column).FlexShrink(0),
+  };
+  const auto item = BeginWidget<Widgets::Widget>(
+    ID {repeater->GetItemID(index)}, ItemStyleClass, BaseStyle);
+  if (repeater->GetItemSizing() == ItemSizing::Fixed) {
+    item->AddMutableStyles(Style().Height(repeater->GetItemHeight()));
+  }
+}
+
+void EndItemsRepeaterItem() {
+  EndWidget<Widgets::Widget>();
+}
+
+}// namespace FredEmmott::GUI::Immediate::immediate_detail
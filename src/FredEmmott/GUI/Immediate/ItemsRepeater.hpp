@@ -0,0 +1,69 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FredEmmott/GUI/Widgets/ItemsRepeater.hpp>
+#include <FredEmmott/GUI/detail/immediate/Widget.hpp>
+#include <functional>
+
+#include "ScrollView.hpp"
+
+namespace FredEmmott::GUI::Immediate {
+
+using ItemSizing = Widgets::ItemsRepeater::ItemSizing;
+
+namespace immediate_detail {
+Widgets::ItemsRepeater::RealizedRange BeginItemsRepeater(
+  std::size_t itemCount,
+  ItemSizing,
+  float itemHeight,
+  ID id);
+void EndItemsRepeater();
+
+void BeginItemsRepeaterItem(std::size_t index);
+void EndItemsRepeaterItem();
+}// namespace immediate_detail
+
+/** Show `itemCount` items, calling `renderItem(index)` only for the items
+ * that are in or near the viewport of the containing ScrollView.
+ *
+ * With `ItemSizing::Fixed`, every item is exactly `itemHeight` tall; with
+ * `ItemSizing::Estimated`, `itemHeight` is only used until there are items to
+ * measure.
+ *
+ * Widgets are recycled between items as they scroll in and out of view; each
+ * call to `renderItem()` should produce the same widget structure, and should
+ * not rely on widget state belonging to a specific index.
+ */
+template <std::invocable<std::size_t> F>
+void ItemsRepeater(
+  const std::size_t itemCount,
+  const ItemSizing sizing,
+  const float itemHeight,
+  F&& renderItem,
+  const ID id = ID {std::source_location::current()}) {
+  using namespace immediate_detail;
+  const auto [begin, end]
+    = BeginItemsRepeater(itemCount, sizing, itemHeight, id);
+  for (auto i = begin; i < end; ++i) {
+    BeginItemsRepeaterItem(i);
+    std::invoke(renderItem, i);
+    EndItemsRepeaterItem();
+  }
+  EndItemsRepeater();
+}
+
+/// A vertical ScrollView containing an ItemsRepeater
+template <std::invocable<std::size_t> F>
+void ListView(
+  const std::size_t itemCount,
+  const ItemSizing sizing,
+  const float itemHeight,
+  F&& renderItem,
+  const ID id = ID {std::source_location::current()}) {
+  const auto scrollView = BeginVScrollView(id).Scoped();
+  ItemsRepeater(
+    itemCount, sizing, itemHeight, std::forward<F>(renderItem), ID {0});
+}
+
+}// namespace FredEmmott::GUI::Immediate
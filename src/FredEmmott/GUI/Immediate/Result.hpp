@@ -4,6 +4,7 @@
 
 #include <FredEmmott/GUI/Style.hpp>
 #include <FredEmmott/GUI/Widgets/Widget.hpp>
+#include <FredEmmott/GUI/detail/immediate/PaintCachedResultMixin.hpp>
 #include <FredEmmott/GUI/detail/immediate/ScopeableResultMixin.hpp>
 #include <FredEmmott/GUI/detail/immediate/StyledResultMixin.hpp>
 #include <FredEmmott/GUI/detail/immediate/ValueResultMixin.hpp>
@@ -13,6 +14,7 @@ namespace FredEmmott::GUI::Immediate {
 template <void (*TEndWidget)() = nullptr, class TValue = void, class... TMixins>
 class Result final
   : public immediate_detail::StyledResultMixin<TMixins...>,
+    public immediate_detail::PaintCachedResultMixin<TMixins...>,
     public immediate_detail::ValueResultMixin<TValue>,
     public immediate_detail::
       ScopeableResultMixin<TEndWidget, TValue, TMixins...>,
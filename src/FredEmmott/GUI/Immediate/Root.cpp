@@ -5,6 +5,7 @@
 
 #include <Yoga.h>
 
+#include <FredEmmott/GUI/FrameProfiler.hpp>
 #include <FredEmmott/GUI/Widgets/Widget.hpp>
 #include <FredEmmott/GUI/detail/immediate_detail.hpp>
 #include <felly/scope_exit.hpp>
@@ -45,7 +46,7 @@ void Root::BeginFrame() {
   PushParentOverride(mImmediateRoot);
 }
 
-void Root::EndFrame() {
+void Root::EndFrame(const std::chrono::steady_clock::time_point now) {
   if (tStack.size() != 2) {
     throw std::logic_error("EndFrame() called, but children are open");
   }
@@ -56,7 +57,15 @@ void Root::EndFrame() {
     mImmediateRoot->GetStructuralChildren().size() == 1,
     "Immediate widget root must have a single child, usually a layout or "
     "card");
-  mActualRoot->ComputeStyles({});
+
+  // Some widgets resolve theme resources in `OnComputedStyleChange()`
+  if (const auto theme = StaticTheme::GetCurrent(); theme != mStyledTheme) {
+    mStyledTheme = theme;
+    mActualRoot->MarkSubtreeStyleDirty();
+  }
+  mFocusManager.MarkFocusChangesStyleDirty();
+  mTransitionEngine.Update(now);
+  mActualRoot->ComputeStyles(Style {});
 
   if (tResizeThisFrame) {
     tWindow->ResizeToIdeal();
@@ -68,13 +77,17 @@ Widget* Root::DispatchEvent(const Event& e) {
   return mActualRoot->DispatchEvent(e);
 }
 
-void Root::Paint(Renderer* renderer, const Size& size) {
+Rect Root::UpdateLayout(
+  Renderer* renderer,
+  const Size& size,
+  const std::chrono::steady_clock::time_point now) {
   const auto clipRegion = renderer->ScopedClipRect({size});
 
-  const auto frameStartTime = std::chrono::steady_clock::now();
-
-  YGNodeCalculateLayout(
-    this->GetLayoutNode(), size.mWidth, size.mHeight, YGDirectionLTR);
+  {
+    const FrameProfiler::ScopedPhase phase {FramePhase::Layout};
+    YGNodeCalculateLayout(
+      this->GetLayoutNode(), size.mWidth, size.mHeight, YGDirectionLTR);
+  }
 
   if constexpr (Config::Debug) {
     const auto width = YGNodeLayoutGetWidth(this->GetLayoutNode());
@@ -87,7 +100,18 @@ void Root::Paint(Renderer* renderer, const Size& size) {
     FUI_ALWAYS_ASSERT(std::abs(height - size.mHeight) < 1.0f);
   }
 
-  mActualRoot->Tick(frameStartTime);
+  {
+    const FrameProfiler::ScopedPhase phase {FramePhase::Tick};
+    mActualRoot->Tick(now);
+  }
+
+  Rect damage {};
+  mActualRoot->CollectPaintDamage(renderer, &damage);
+  return damage;
+}
+
+void Root::Paint(Renderer* renderer, const Size& size) {
+  const auto clipRegion = renderer->ScopedClipRect({size});
   mActualRoot->Paint(renderer);
 }
 
@@ -118,6 +142,14 @@ FocusManager* Root::GetFocusManager() const {
   return &const_cast<Root*>(this)->mFocusManager;
 }
 
+FrameScheduler* Root::GetFrameScheduler() const {
+  return &const_cast<Root*>(this)->mFrameScheduler;
+}
+
+TransitionEngine* Root::GetTransitionEngine() const {
+  return &const_cast<Root*>(this)->mTransitionEngine;
+}
+
 Size Root::GetInitialSize() const {
   return GetMinimumWidthAndIdealHeight(this->GetLayoutNode());
 }
@@ -126,11 +158,12 @@ float Root::GetHeightForWidth(float width) const {
   return GetIdealHeight(this->GetLayoutNode(), width);
 }
 
-FrameRateRequirement Root::GetFrameRateRequirement() const {
+FrameRateRequirement Root::GetFrameRateRequirement(
+  const std::chrono::steady_clock::time_point now) const {
   if (std::exchange(tNeedAdditionalFrame, false)) {
     return FrameRateRequirement::SmoothAnimation {};
   }
-  return mActualRoot->GetFrameRateRequirement();
+  return this->GetFrameScheduler()->GetFrameRateRequirement(now);
 }
 
 }// namespace FredEmmott::GUI::Immediate
\ No newline at end of file
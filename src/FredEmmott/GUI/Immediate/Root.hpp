@@ -3,10 +3,15 @@
 #pragma once
 
 #include <FredEmmott/GUI/FrameRateRequirement.hpp>
+#include <FredEmmott/GUI/FrameScheduler.hpp>
+#include <FredEmmott/GUI/Rect.hpp>
 #include <FredEmmott/GUI/Renderer.hpp>
 #include <FredEmmott/GUI/Size.hpp>
+#include <FredEmmott/GUI/StaticTheme/Theme.hpp>
+#include <FredEmmott/GUI/TransitionEngine.hpp>
 #include <FredEmmott/GUI/events/Event.hpp>
 #include <FredEmmott/GUI/yoga.hpp>
+#include <chrono>
 
 #include "FredEmmott/GUI/FocusManager.hpp"
 
@@ -25,7 +30,21 @@ class Root final {
   void Reset();
 
   void BeginFrame();
-  void EndFrame();
+  /// `now` is the time that style transitions are evaluated at
+  void EndFrame(std::chrono::steady_clock::time_point now);
+  /** Lay out and tick the widget tree, and return the area that needs
+   * repainting, in device space.
+   *
+   * `renderer` must have the transform that will be used for `Paint()`; this
+   * does not draw anything.
+   *
+   * `now` is the time that animations are ticked to.
+   */
+  [[nodiscard]]
+  Rect UpdateLayout(
+    Renderer*,
+    const Size&,
+    std::chrono::steady_clock::time_point now);
   void Paint(Renderer*, const Size&);
 
   [[nodiscard]]
@@ -36,6 +55,8 @@ class Root final {
   Size GetInitialSize() const;
 
   FocusManager* GetFocusManager() const;
+  FrameScheduler* GetFrameScheduler() const;
+  TransitionEngine* GetTransitionEngine() const;
 
   Widgets::Widget* GetImplementationRoot() const {
     return mActualRoot;
@@ -46,7 +67,8 @@ class Root final {
   }
 
   float GetHeightForWidth(float) const;
-  FrameRateRequirement GetFrameRateRequirement() const;
+  FrameRateRequirement GetFrameRateRequirement(
+    std::chrono::steady_clock::time_point now) const;
 
   Widgets::Widget* DispatchEvent(const Event&);
 
@@ -54,7 +76,11 @@ class Root final {
   Widgets::Widget* mActualRoot {};
   Widgets::Widget* mImmediateRoot {};
   FocusManager mFocusManager;
+  FrameScheduler mFrameScheduler;
+  TransitionEngine mTransitionEngine;
   unique_yoga_node_ptr mYogaRoot;
+  // Theme used for the last `ComputeStyles()`
+  std::optional<StaticTheme::Theme> mStyledTheme;
 };
 
 }// namespace FredEmmott::GUI::Immediate
\ No newline at end of file
@@ -12,10 +12,10 @@ namespace FredEmmott::GUI::Immediate {
 namespace {
 constexpr LiteralStyleClass TextBoxClearButtonStyleClass {
   "TextBox/ClearButton"};
-}
 
 [[nodiscard]]
-TextBoxResult TextBox(std::string* text, const ID id) {
+TextBoxResult
+TextBoxImpl(std::string* text, const ID id, const bool isMultiLine) {
   using namespace StaticTheme::TextBox;
 
   if (!text) [[unlikely]] {
@@ -27,7 +27,10 @@ TextBoxResult TextBox(std::string* text, const ID id) {
     immediate_detail::EndWidget<Widgets::TextBox>();
   });
 
-  if (!w->GetText().empty()) {
+  w->SetMultiLine(isMultiLine);
+
+  // As with WinUI, multi-line text boxes do not have a clear button
+  if (!(isMultiLine || w->GetText().empty())) {
     const auto clearButton = immediate_detail::BeginWidget<Widgets::Button>(
       ID {0},
       TextBoxClearButtonStyleClass,
@@ -53,4 +56,14 @@ TextBoxResult TextBox(std::string* text, const ID id) {
   return {w, false};
 }
 
+}// namespace
+
+TextBoxResult TextBox(std::string* text, const ID id) {
+  return TextBoxImpl(text, id, false);
+}
+
+TextBoxResult MultiLineTextBox(std::string* text, const ID id) {
+  return TextBoxImpl(text, id, true);
+}
+
 }// namespace FredEmmott::GUI::Immediate
\ No newline at end of file
@@ -25,4 +25,14 @@ TextBoxResult TextBox(
   std::string* text,
   ID id = ID {std::source_location::current()});
 
+/** A word-wrapping text box that accepts newlines.
+ *
+ * This grows to fit its content; put it in a `ScrollView` to limit its height.
+ * Only the lines visible in the `ScrollView` are painted.
+ */
+[[nodiscard]]
+TextBoxResult MultiLineTextBox(
+  std::string* text,
+  ID id = ID {std::source_location::current()});
+
 }// namespace FredEmmott::GUI::Immediate
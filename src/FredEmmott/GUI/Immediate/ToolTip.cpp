@@ -35,7 +35,7 @@ void EndToolTip() {
   const auto ctx = p->GetContext<ToolTipContainerContext>()
                      ->mAnchor->GetContext<ToolTipAnchorContext>();
   if (const auto cursorPoint = std::exchange(ctx->mAnchorTo, std::nullopt)) {
-    p->ComputeStyles({});
+    p->ComputeStyles(Style {});
     const auto [width, height]
       = GetMinimumWidthAndIdealHeight(p->GetLayoutNode());
 
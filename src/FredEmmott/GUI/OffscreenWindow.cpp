@@ -0,0 +1,347 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#include "OffscreenWindow.hpp"
+
+#include <skia/core/SkCanvas.h>
+#include <skia/core/SkImageInfo.h>
+#include <skia/core/SkSurface.h>
+
+#include <FredEmmott/GUI/StaticTheme.hpp>
+#include <FredEmmott/GUI/StaticTheme/Common.hpp>
+#include <FredEmmott/GUI/Widgets/Widget.hpp>
+#include <FredEmmott/GUI/events/TextInputEvent.hpp>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "SkiaRenderer.hpp"
+#include "assert.hpp"
+#include "detail/renderer_detail.hpp"
+#include "detail/skia_detail.hpp"
+
+namespace FredEmmott::GUI {
+
+namespace {
+constexpr LiteralStyleClass ActualRootStyleClass {"OffscreenWindow/Root"};
+constexpr LiteralStyleClass ImmediateRootStyleClass {
+  "OffscreenWindow/ImmediateRoot"};
+auto& ActualRootStyles() {
+  static const ImmutableStyle ret {
+    Style().FlexDirection(FlexDirection::Column).FlexGrow(1),
+  };
+  return ret;
+}
+auto& ImmediateRootStyles() {
+  static const ImmutableStyle ret {
+    ActualRootStyles() + Style().FlexShrink(1).FlexGrow(1),
+  };
+  return ret;
+}
+
+// Matches `USER_DEFAULT_SCREEN_DPI` on Windows
+constexpr uint64_t NominalDPI = 96;
+
+// Raster drawing is complete as soon as the draw call returns
+struct RasterCompletionFlag final : GPUCompletionFlag {
+  ~RasterCompletionFlag() override = default;
+
+  bool IsComplete() const override {
+    return true;
+  }
+
+  void Wait() const override {}
+};
+
+SkImageInfo GetImageInfo(const int width, const int height) {
+  return SkImageInfo::Make(
+    width, height, kBGRA_8888_SkColorType, kPremul_SkAlphaType);
+}
+
+bool IsAllowed(const Window::ResizeMode mode, const Window::ResizeMode flag) {
+  return (std::to_underlying(mode) & std::to_underlying(flag))
+    == std::to_underlying(flag);
+}
+
+float ResizeDimension(
+  const float current,
+  const float ideal,
+  const Window::ResizeMode mode) {
+  using enum Window::ResizeMode;
+  if (ideal > current && IsAllowed(mode, AllowGrow)) {
+    return ideal;
+  }
+  if (ideal < current && IsAllowed(mode, AllowShrink)) {
+    return ideal;
+  }
+  return current;
+}
+
+}// namespace
+
+class OffscreenWindow::FramePainter final : public BasicFramePainter {
+ public:
+  FramePainter() = delete;
+  explicit FramePainter(OffscreenWindow* window)
+    : mRenderer(
+        GetNativeDevice(window->GetDPIScale()),
+        window->mSurface->getCanvas(),
+        std::make_shared<RasterCompletionFlag>()) {}
+  ~FramePainter() override = default;
+
+  Renderer* GetRenderer() noexcept override {
+    return &mRenderer;
+  }
+
+ private:
+  SkiaRenderer mRenderer;
+
+  static SkiaRenderer::NativeDevice GetNativeDevice(const float dpiScale) {
+    SkiaRenderer::NativeDevice ret {};
+#ifdef _WIN32
+    ret.mDPI = {
+      .mActual = static_cast<uint64_t>(std::lround(dpiScale * NominalDPI)),
+      .mNominal = NominalDPI,
+    };
+#endif
+    return ret;
+  }
+};
+
+OffscreenWindow::OffscreenWindow(const Options& options)
+  : OffscreenWindow(
+      std::make_unique<Widgets::Widget>(
+        this,
+        ActualRootStyleClass,
+        ActualRootStyles()),
+      new Widgets::Widget(this, ImmediateRootStyleClass, ImmediateRootStyles()),
+      options) {}
+
+OffscreenWindow::OffscreenWindow(
+  std::unique_ptr<Widgets::Widget> actualRoot,
+  Widgets::Widget* immediateRoot,
+  const Options& options)
+  : Window(actualRoot.get(), immediateRoot, /* swapChainLength = */ 1),
+    mActualRoot(std::move(actualRoot)),
+    mImmediateRoot(immediateRoot),
+    mOptions(options) {
+  using namespace renderer_detail;
+  if (HaveRenderAPI(RenderAPI::Skia)) {
+    return;
+  }
+  SetRenderAPI(
+    RenderAPI::Skia, "Skia(Raster)", skia_detail::CreateFontMetricsProvider());
+}
+
+OffscreenWindow::~OffscreenWindow() = default;
+
+std::unique_ptr<Window> OffscreenWindow::CreatePopup() const {
+  auto ret = std::make_unique<OffscreenWindow>(
+    Options {
+      .mCanvasSize = mOptions.mCanvasSize,
+      .mDPIScale = mOptions.mDPIScale,
+      .mHorizontalResizeMode = ResizeMode::Allow,
+      .mVerticalResizeMode = ResizeMode::Allow,
+      .mClock = mOptions.mClock,
+    });
+  ret->mIsPopup = true;
+  return ret;
+}
+
+void OffscreenWindow::InitializeWidgetTree() {
+  mActualRoot->SetStructuralChildren({mImmediateRoot});
+}
+
+void OffscreenWindow::InitializeGraphicsAPI() {}
+
+void OffscreenWindow::InitializeWindow() {
+  this->ResizeIfNeeded();
+}
+
+void OffscreenWindow::ResizeIfNeeded() {
+  const auto width = static_cast<int>(
+    std::ceil(mOptions.mCanvasSize.mWidth * mOptions.mDPIScale));
+  const auto height = static_cast<int>(
+    std::ceil(mOptions.mCanvasSize.mHeight * mOptions.mDPIScale));
+  if (
+    mSurface && mSurface->width() == width && mSurface->height() == height) {
+    return;
+  }
+  // `SoftwareBitmap` dimensions are 16-bit
+  FUI_ASSERT(width <= std::numeric_limits<uint16_t>::max());
+  FUI_ASSERT(height <= std::numeric_limits<uint16_t>::max());
+  mSurface = SkSurfaces::Raster(GetImageInfo(width, height));
+  mHavePaintedFrame = false;
+  if (!mSurface) {
+    throw std::runtime_error(
+      std::format("Failed to create a {}x{} raster surface", width, height));
+  }
+  this->ResetToFirstBackBuffer();
+}
+
+void OffscreenWindow::SetCanvasSize(const Size& size) {
+  FUI_ASSERT(size.mWidth > 0 && size.mHeight > 0);
+  mOptions.mCanvasSize = size;
+}
+
+void OffscreenWindow::SetResizeMode(
+  const ResizeMode horizontal,
+  const ResizeMode vertical) {
+  mOptions.mHorizontalResizeMode = horizontal;
+  mOptions.mVerticalResizeMode = vertical;
+}
+
+void OffscreenWindow::ResizeToIdeal() {
+  const auto ideal = this->GetRoot()->GetInitialSize();
+  auto& size = mOptions.mCanvasSize;
+  size.mWidth = ResizeDimension(
+    size.mWidth, std::ceil(ideal.mWidth), mOptions.mHorizontalResizeMode);
+  size.mHeight = ResizeDimension(
+    size.mHeight,
+    std::ceil(this->GetRoot()->GetHeightForWidth(size.mWidth)),
+    mOptions.mVerticalResizeMode);
+}
+
+std::unique_ptr<Window::BasicFramePainter> OffscreenWindow::GetFramePainter(
+  [[maybe_unused]] uint8_t frameIndex) {
+  FUI_ASSERT(mSurface);
+  mHavePaintedFrame = true;
+  return std::make_unique<FramePainter>(this);
+}
+
+Color OffscreenWindow::GetClearColor() const {
+  return StaticTheme::Common::SolidBackgroundFillColorBase.Resolve(
+    StaticTheme::GetCurrent());
+}
+
+NativePoint OffscreenWindow::CanvasPointToNativePoint(
+  const Point& canvas) const {
+  return {
+    static_cast<int32_t>(std::lround(canvas.mX * mOptions.mDPIScale)),
+    static_cast<int32_t>(std::lround(canvas.mY * mOptions.mDPIScale)),
+  };
+}
+
+Point OffscreenWindow::NativePointToCanvasPoint(
+  const NativePoint& native) const {
+  return {
+    native.mX / mOptions.mDPIScale,
+    native.mY / mOptions.mDPIScale,
+  };
+}
+
+std::optional<std::string> OffscreenWindow::GetClipboardText() const {
+  return mClipboardText;
+}
+
+void OffscreenWindow::SetClipboardText(const std::string_view text) const {
+  mClipboardText = std::string {text};
+}
+
+void OffscreenWindow::QueueEvent(const MouseEvent& e) {
+  this->Enqueue(e);
+}
+
+void OffscreenWindow::QueueEvent(const KeyPressEvent& e) {
+  this->Enqueue(e);
+}
+
+void OffscreenWindow::QueueEvent(const KeyReleaseEvent& e) {
+  this->Enqueue(e);
+}
+
+void OffscreenWindow::QueueTextInput(const std::string_view text) {
+  this->Enqueue(QueuedTextInput {std::string {text}});
+}
+
+void OffscreenWindow::Enqueue(QueuedEvent e) {
+  {
+    std::unique_lock lock(mMutex);
+    mEventQueue.push_back(std::move(e));
+  }
+  mWakeCondition.notify_all();
+}
+
+void OffscreenWindow::ProcessNativeEvents() {
+  std::deque<QueuedEvent> events;
+  {
+    std::unique_lock lock(mMutex);
+    events.swap(mEventQueue);
+  }
+  for (auto&& e: events) {
+    if (this->GetExitCode()) {
+      return;
+    }
+    std::visit(
+      [this]<class T>(const T& it) {
+        if constexpr (std::same_as<T, QueuedTextInput>) {
+          this->DispatchEvent(TextInputEvent {it.mText});
+        } else if constexpr (std::same_as<T, MouseEvent>) {
+          std::ignore = this->DispatchEvent(it);
+        } else {
+          this->DispatchEvent(it);
+        }
+      },
+      e);
+  }
+}
+
+void OffscreenWindow::InterruptWaitFrame() {
+  {
+    std::unique_lock lock(mMutex);
+    mWaitFrameInterrupted = true;
+  }
+  mWakeCondition.notify_all();
+}
+
+std::chrono::steady_clock::time_point OffscreenWindow::GetClockNow() const {
+  if (mOptions.mClock) {
+    return mOptions.mClock();
+  }
+  return std::chrono::steady_clock::now();
+}
+
+void OffscreenWindow::WaitFrameImpl(
+  [[maybe_unused]] std::span<const NativeWaitable> nativeWaitables,
+  const std::chrono::steady_clock::time_point until) const {
+  std::unique_lock lock(mMutex);
+  const auto isReady = [this] {
+    return mWaitFrameInterrupted || !mEventQueue.empty();
+  };
+  // The caller owns the clock, so there's nothing to wait for
+  if (mOptions.mClock) {
+    mWaitFrameInterrupted = false;
+    return;
+  }
+  if (until == std::chrono::steady_clock::time_point::max()) {
+    mWakeCondition.wait(lock, isReady);
+  } else {
+    mWakeCondition.wait_until(lock, until, isReady);
+  }
+  mWaitFrameInterrupted = false;
+}
+
+SoftwareBitmap OffscreenWindow::GetFrame() const {
+  if (!mHavePaintedFrame) {
+    throw std::logic_error("OffscreenWindow has not painted a frame");
+  }
+  const auto width = mSurface->width();
+  const auto height = mSurface->height();
+
+  SoftwareBitmap ret {
+    .mPixelLayout = SoftwareBitmap::PixelLayout::BGRA32,
+    .mAlphaFormat = SoftwareBitmap::AlphaFormat::Premultiplied,
+    .mWidth = static_cast<uint16_t>(width),
+    .mHeight = static_cast<uint16_t>(height),
+  };
+  const auto pitch = static_cast<std::size_t>(width) * 4;
+  ret.mData.resize(pitch * height);
+  if (!mSurface->readPixels(
+        GetImageInfo(width, height), ret.mData.data(), pitch, 0, 0)) {
+    throw std::runtime_error("Failed to read OffscreenWindow pixels");
+  }
+  return ret;
+}
+
+}// namespace FredEmmott::GUI
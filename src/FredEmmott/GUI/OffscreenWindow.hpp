@@ -0,0 +1,186 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <skia/core/SkRefCnt.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <variant>
+
+#include "SoftwareBitmap.hpp"
+#include "Window.hpp"
+#include "events/KeyEvent.hpp"
+#include "events/MouseEvent.hpp"
+
+class SkSurface;
+
+namespace FredEmmott::GUI {
+
+struct OffscreenWindowOptions {
+  Size mCanvasSize {640, 480};
+  float mDPIScale {1.0f};
+
+  Window::ResizeMode mHorizontalResizeMode = Window::ResizeMode::Fixed;
+  Window::ResizeMode mVerticalResizeMode = Window::ResizeMode::Fixed;
+
+  /** Used for frame timing and animations.
+   *
+   * If set, `WaitFrame()` does not block; the clock is expected to be advanced
+   * by the caller between frames.
+   *
+   * If not set, `std::chrono::steady_clock::now()` is used.
+   */
+  std::function<std::chrono::steady_clock::time_point()> mClock;
+};
+
+/** A window without a native window, drawing to a CPU Skia raster surface.
+ *
+ * This is intended for tests, screenshots, and server-side rendering: input
+ * is provided by `QueueEvent()`/`QueueTextInput()`, and dispatched by the
+ * next `BeginFrame()`; after `EndFrame()`, the frame can be retrieved with
+ * `GetFrame()`.
+ *
+ * Popups are also offscreen windows; their content is not composited into
+ * this window's frame.
+ */
+class OffscreenWindow final : public Window {
+ public:
+  using Options = OffscreenWindowOptions;
+
+  explicit OffscreenWindow(const Options& options = {});
+  ~OffscreenWindow() override;
+
+  [[nodiscard]]
+  std::unique_ptr<Window> CreatePopup() const override;
+  void SetParent(NativeHandle) override {}
+  void SetTitle(std::string_view title) override {
+    mTitle = std::string {title};
+  }
+  [[nodiscard]]
+  bool SetSubtitle(std::string_view) override {
+    return false;
+  }
+  [[nodiscard]]
+  NativeHandle GetNativeHandle() const noexcept override {
+    return {};
+  }
+  void SetInitialPositionInNativeCoords(const NativePoint&) override {}
+  void OffsetPositionToDescendant(Widgets::Widget*) override {}
+  void ResizeToIdeal() override;
+  [[nodiscard]]
+  bool IsDisabled() const override {
+    return false;
+  }
+  void SetResizeMode(ResizeMode horizontal, ResizeMode vertical) override;
+  [[nodiscard]]
+  NativePoint CanvasPointToNativePoint(const Point& canvas) const override;
+  [[nodiscard]]
+  Point NativePointToCanvasPoint(const NativePoint& native) const override;
+
+  void InterruptWaitFrame() override;
+
+  std::optional<std::string> GetClipboardText() const override;
+  void SetClipboardText(std::string_view) const override;
+
+  [[nodiscard]]
+  bool IsPopup() const noexcept override {
+    return mIsPopup;
+  }
+  void SetIsToolTip() override {}
+
+  [[nodiscard]]
+  std::string_view GetTitle() const noexcept {
+    return mTitle;
+  }
+
+  /// Change the size of the canvas, in device-independent pixels
+  void SetCanvasSize(const Size&);
+
+  void QueueEvent(const MouseEvent&);
+  void QueueEvent(const KeyPressEvent&);
+  void QueueEvent(const KeyReleaseEvent&);
+  void QueueTextInput(std::string_view);
+
+  /** The most recently painted frame, in device pixels.
+   *
+   * Throws an `std::logic_error` if no frame has been painted.
+   */
+  [[nodiscard]]
+  SoftwareBitmap GetFrame() const;
+
+  using Window::GetFrameDamage;
+
+ protected:
+  void SetBackdrop(const WindowBackdrop&) override {}
+  void ProcessNativeEvents() override;
+  void InitializeWindow() override;
+  void HideWindow() override {}
+  std::unique_ptr<BasicFramePainter> GetFramePainter(
+    uint8_t frameIndex) override;
+  void ResizeIfNeeded() override;
+  Size GetCanvasSize() const override {
+    return mOptions.mCanvasSize;
+  }
+  float GetDPIScale() const override {
+    return mOptions.mDPIScale;
+  }
+  Color GetClearColor() const override;
+  void InitializeGraphicsAPI() override;
+  void InitializeWidgetTree() override;
+  // The surface is only written to by `Paint()`
+  [[nodiscard]]
+  bool IsCanvasRetained() const noexcept override {
+    return true;
+  }
+  [[nodiscard]]
+  bool IsWindowInitialized() const noexcept override {
+    return static_cast<bool>(mSurface);
+  }
+  [[nodiscard]]
+  std::chrono::steady_clock::time_point GetClockNow() const override;
+  void WaitFrameImpl(
+    std::span<const NativeWaitable>,
+    std::chrono::steady_clock::time_point until) const override;
+
+ private:
+  OffscreenWindow(
+    std::unique_ptr<Widgets::Widget> actualRoot,
+    Widgets::Widget* immediateRoot,
+    const Options& options);
+
+  class FramePainter;
+
+  struct QueuedTextInput {
+    std::string mText;
+  };
+  using QueuedEvent = std::variant<
+    MouseEvent,
+    KeyPressEvent,
+    KeyReleaseEvent,
+    QueuedTextInput>;
+
+  std::unique_ptr<Widgets::Widget> mActualRoot;
+  Widgets::Widget* mImmediateRoot {nullptr};
+  Options mOptions;
+  std::string mTitle;
+  bool mIsPopup {false};
+  mutable std::optional<std::string> mClipboardText;
+
+  sk_sp<SkSurface> mSurface;
+  bool mHavePaintedFrame {false};
+
+  mutable std::mutex mMutex;
+  mutable std::condition_variable mWakeCondition;
+  std::deque<QueuedEvent> mEventQueue;
+  mutable bool mWaitFrameInterrupted {false};
+
+  void Enqueue(QueuedEvent);
+};
+
+}// namespace FredEmmott::GUI
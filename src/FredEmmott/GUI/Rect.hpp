@@ -5,6 +5,7 @@
 #include <Windows.h>
 
 #include <FredEmmott/GUI/config.hpp>
+#include <algorithm>
 #include <concepts>
 #include <cstdint>
 
@@ -163,6 +164,56 @@ struct BasicRect {
     return ret;
   }
 
+  [[nodiscard]]
+  constexpr bool IsEmpty() const noexcept {
+    return !(mSize.mWidth > 0 && mSize.mHeight > 0);
+  }
+
+  [[nodiscard]]
+  constexpr bool Intersects(const BasicRect& other) const noexcept {
+    return GetLeft() < other.GetRight() && other.GetLeft() < GetRight()
+      && GetTop() < other.GetBottom() && other.GetTop() < GetBottom();
+  }
+
+  /// Returns an empty rect if there is no intersection
+  [[nodiscard]]
+  constexpr BasicRect GetIntersection(const BasicRect& other) const noexcept {
+    if (!this->Intersects(other)) {
+      return {};
+    }
+    return {
+      BasicPoint<T> {
+        std::max(GetLeft(), other.GetLeft()),
+        std::max(GetTop(), other.GetTop()),
+      },
+      BasicPoint<T> {
+        std::min(GetRight(), other.GetRight()),
+        std::min(GetBottom(), other.GetBottom()),
+      },
+    };
+  }
+
+  /// The bounding box of both rects; empty rects are ignored
+  [[nodiscard]]
+  constexpr BasicRect GetUnion(const BasicRect& other) const noexcept {
+    if (other.IsEmpty()) {
+      return *this;
+    }
+    if (this->IsEmpty()) {
+      return other;
+    }
+    return {
+      BasicPoint<T> {
+        std::min(GetLeft(), other.GetLeft()),
+        std::min(GetTop(), other.GetTop()),
+      },
+      BasicPoint<T> {
+        std::max(GetRight(), other.GetRight()),
+        std::max(GetBottom(), other.GetBottom()),
+      },
+    };
+  }
+
 #ifdef FUI_ENABLE_SKIA
   constexpr operator SkRect() const noexcept
     requires std::same_as<float, T>
@@ -12,6 +12,7 @@
 #include "Font.hpp"
 #include "Point.hpp"
 #include "Rect.hpp"
+#include "ShapedText.hpp"
 
 namespace FredEmmott::GUI {
 struct SoftwareBitmap;
@@ -49,6 +50,11 @@ struct GPUCompletionFlag {
   virtual void Wait() const = 0;
 };
 
+/// Drawing commands captured by `Renderer::BeginRecording()`
+struct PaintRecording {
+  virtual ~PaintRecording() = default;
+};
+
 enum class StrokeCap {
   /** End exactly at the end of the stroke, no cap.
    *
@@ -103,6 +109,42 @@ class Renderer {
     return felly::scope_exit([this] { PopClipRect(); });
   }
 
+  /** The bounding box of the current clip region, in device space.
+   *
+   * This may be larger than the actual clip region.
+   */
+  [[nodiscard]]
+  virtual Rect GetDeviceClipBounds() const = 0;
+
+  /** Returns true if `rect` is definitely outside of the clip region.
+   *
+   * `rect` is in the current coordinate space, i.e. it is transformed before
+   * being compared to the clip region. May return false even if nothing
+   * in the rect would be visible.
+   */
+  [[nodiscard]]
+  virtual bool QuickReject(const Rect& rect) const = 0;
+
+  /// The bounding box of `rect` after transformation to device space
+  [[nodiscard]]
+  virtual Rect GetDeviceBounds(const Rect& rect) const = 0;
+
+  /** Capture subsequent drawing commands instead of executing them.
+   *
+   * Returns false if recording is not supported by this renderer, in which
+   * case drawing commands are executed as normal.
+   *
+   * `bounds` is in the current coordinate space; content outside of it may
+   * be culled from the recording.
+   */
+  [[nodiscard]]
+  virtual bool BeginRecording(const Rect& bounds) = 0;
+  /// Must be called exactly once for each successful `BeginRecording()`
+  [[nodiscard]]
+  virtual std::unique_ptr<PaintRecording> EndRecording() = 0;
+  /// Replay a recording from this renderer in the current coordinate space
+  virtual void DrawRecording(const PaintRecording&) = 0;
+
   [[nodiscard]]
   virtual uint64_t GetPhysicalLength(uint64_t dipLength) = 0;
   [[nodiscard]]
@@ -174,6 +216,16 @@ class Renderer {
     const Font& font,
     std::string_view text,
     const Point& baseline) = 0;
+  /** Draw text from `Font::ShapeText()`.
+   *
+   * Equivalent to `DrawText()` with the same font and text, but does not
+   * shape the text again.
+   */
+  virtual void DrawShapedText(
+    const Brush& brush,
+    const Rect& brushRect,
+    const ShapedText& text,
+    const Point& baseline) = 0;
 
   [[nodiscard]]
   virtual std::unique_ptr<ImportedTexture> ImportTexture(
@@ -0,0 +1,103 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FredEmmott/GUI/config.hpp>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "Font.hpp"
+
+#ifdef FUI_ENABLE_SKIA
+#include <skia/core/SkRefCnt.h>
+#include <skia/core/SkTextBlob.h>
+#endif
+
+#ifdef FUI_ENABLE_DIRECT2D
+#include <dwrite.h>
+#include <wil/com.h>
+#endif
+
+namespace FredEmmott::GUI {
+
+namespace detail {
+template <class T>
+struct is_native_shaped_text_t : std::false_type {};
+
+#ifdef FUI_ENABLE_SKIA
+template <>
+struct is_native_shaped_text_t<sk_sp<SkTextBlob>> : std::true_type {};
+#endif
+
+#ifdef FUI_ENABLE_DIRECT2D
+template <>
+struct is_native_shaped_text_t<wil::com_ptr<IDWriteTextLayout>>
+  : std::true_type {};
+#endif
+}// namespace detail
+
+template <class T>
+concept native_shaped_text = detail::is_native_shaped_text_t<T>::value;
+
+/** A single line of text that has already been shaped with a specific font.
+ *
+ * Shaping is most of the cost of drawing text; widgets that draw the same
+ * text every frame should create this with `Font::ShapeText()` when the text
+ * or font changes, then pass it to `Renderer::DrawShapedText()`.
+ */
+class ShapedText {
+ public:
+  ShapedText() = default;
+#ifdef FUI_ENABLE_SKIA
+  ShapedText(const Font& font, const float width, sk_sp<SkTextBlob> blob)
+    : mFont(font),
+      mWidth(width),
+      mNative(std::move(blob)) {}
+#endif
+#ifdef FUI_ENABLE_DIRECT2D
+  ShapedText(
+    const Font& font,
+    const float width,
+    wil::com_ptr<IDWriteTextLayout> layout)
+    : mFont(font),
+      mWidth(width),
+      mNative(std::move(layout)) {}
+#endif
+
+  [[nodiscard]]
+  const Font& GetFont() const noexcept {
+    return mFont;
+  }
+
+  /// Same as `Font::MeasureTextWidth()`
+  [[nodiscard]]
+  float GetWidth() const noexcept {
+    return mWidth;
+  }
+
+  /// May be null if the text is empty
+  template <native_shaped_text T>
+  const T& as() const {
+    return std::get<T>(mNative);
+  }
+
+  constexpr operator bool() const noexcept {
+    return !std::holds_alternative<std::monostate>(mNative);
+  }
+
+ private:
+  Font mFont;
+  float mWidth {};
+  std::variant<
+#ifdef FUI_ENABLE_SKIA
+    sk_sp<SkTextBlob>,
+#endif
+#ifdef FUI_ENABLE_DIRECT2D
+    wil::com_ptr<IDWriteTextLayout>,
+#endif
+    std::monostate>
+    mNative {std::monostate {}};
+};
+
+}// namespace FredEmmott::GUI
@@ -4,8 +4,11 @@
 #include "SkiaRenderer.hpp"
 
 #include <skia/core/SkImage.h>
+#include <skia/core/SkPicture.h>
 #include <skia/core/SkRRect.h>
+#include <skia/core/SkTextBlob.h>
 
+#include <FredEmmott/GUI/FrameProfiler.hpp>
 #include <FredEmmott/GUI/detail/renderer_detail.hpp>
 
 #include "SoftwareBitmap.hpp"
@@ -31,6 +34,12 @@ struct ImportedSkiaTexture : ImportedTexture {
   sk_sp<SkImage> mSkiaImage;
 };
 
+struct SkiaPaintRecording : PaintRecording {
+  ~SkiaPaintRecording() override = default;
+
+  sk_sp<SkPicture> mSkiaPicture;
+};
+
 struct ImportedSkiaFence : ImportedFence {
   ~ImportedSkiaFence() override = default;
 
@@ -66,6 +75,7 @@ SkiaRenderer::SkiaRenderer(
 }
 
 SkiaRenderer::~SkiaRenderer() {
+  FUI_ASSERT(mRecordings.empty());
   // `FUI_ASSERT` uses `if constexpr`, which refers to an undefined variable in
   // release builds
 #ifdef FUI_DEBUG
@@ -92,6 +102,7 @@ void SkiaRenderer::PopLayer() {
 }
 
 void SkiaRenderer::Clear(const Color& color) {
+  FrameProfiler::CountDrawCall();
   mCanvas->clear(color.as<SkColor>());
 }
 
@@ -110,12 +121,62 @@ void SkiaRenderer::PopClipRect() {
 #endif
 }
 
+Rect SkiaRenderer::GetDeviceClipBounds() const {
+  const auto bounds = mCanvas->getDeviceClipBounds();
+  return {
+    Point {static_cast<float>(bounds.left()), static_cast<float>(bounds.top())},
+    Point {
+      static_cast<float>(bounds.right()),
+      static_cast<float>(bounds.bottom()),
+    },
+  };
+}
+
+bool SkiaRenderer::QuickReject(const Rect& rect) const {
+  return mCanvas->quickReject(rect);
+}
+
+Rect SkiaRenderer::GetDeviceBounds(const Rect& rect) const {
+  const auto bounds = mCanvas->getTotalMatrix().mapRect(rect);
+  return {
+    Point {bounds.left(), bounds.top()},
+    Point {bounds.right(), bounds.bottom()},
+  };
+}
+
+bool SkiaRenderer::BeginRecording(const Rect& bounds) {
+  auto& recording = mRecordings.emplace_back(
+    std::make_unique<SkPictureRecorder>(), mCanvas);
+  mCanvas = recording.mRecorder->beginRecording(bounds);
+  return true;
+}
+
+std::unique_ptr<PaintRecording> SkiaRenderer::EndRecording() {
+  FUI_ASSERT(!mRecordings.empty());
+  auto recording = std::move(mRecordings.back());
+  mRecordings.pop_back();
+  mCanvas = recording.mParentCanvas;
+
+  auto ret = std::make_unique<SkiaPaintRecording>();
+  ret->mSkiaPicture = recording.mRecorder->finishRecordingAsPicture();
+  return ret;
+}
+
+void SkiaRenderer::DrawRecording(const PaintRecording& recording) {
+  FrameProfiler::CountDrawCall();
+  const auto& skiaRecording
+    = static_cast<const SkiaPaintRecording&>(recording);
+  FUI_ASSERT(dynamic_cast<const SkiaPaintRecording*>(&recording));
+  mCanvas->drawPicture(skiaRecording.mSkiaPicture);
+}
+
 void SkiaRenderer::DrawLine(
   const Brush& brush,
   const Point& start,
   const Point& end,
   const float thickness,
   const StrokeCap strokeCap) {
+  FrameProfiler::CountDrawCall();
   auto paint = brush.as<SkPaint>(this, Rect {start, end});
   paint.setStrokeWidth(thickness);
   paint.setAntiAlias(true);
@@ -137,6 +198,7 @@ void SkiaRenderer::Rotate(const float degrees, const Point& center) {
 }
 
 void SkiaRenderer::FillRect(const Brush& brush, const Rect& rect) {
+  FrameProfiler::CountDrawCall();
   auto paint = brush.as<SkPaint>(this, rect);
   paint.setStyle(SkPaint::Style::kFill_Style);
   mCanvas->drawRect(rect, paint);
@@ -146,6 +208,7 @@ void SkiaRenderer::StrokeRect(
   const Brush& brush,
   const Rect& rect,
   float thickness) {
+  FrameProfiler::CountDrawCall();
   auto paint = brush.as<SkPaint>(this, rect);
   paint.setStyle(SkPaint::Style::kStroke_Style);
   paint.setStrokeWidth(thickness);
@@ -156,6 +219,7 @@ void SkiaRenderer::FillRoundedRect(
   const Brush& brush,
   const Rect& rect,
   const CornerRadius& radii) {
+  FrameProfiler::CountDrawCall();
   auto paint = brush.as<SkPaint>(this, rect);
   paint.setStyle(SkPaint::Style::kFill_Style);
   paint.setAntiAlias(true);
@@ -188,6 +252,7 @@ void SkiaRenderer::StrokeRoundedRect(
   const CornerRadius& radii,
   const EdgeFlags edges,
   const float thickness) {
+  FrameProfiler::CountDrawCall();
   static constexpr auto Epsilon = std::numeric_limits<float>::epsilon();
 
   auto paint = brush.as<SkPaint>(this, rect);
@@ -331,6 +396,7 @@ void SkiaRenderer::StrokeArc(
   const float sweepAngle,
   const float thickness,
   const StrokeCap strokeCap) {
+  FrameProfiler::CountDrawCall();
   if (
     strokeCap == StrokeCap::None
     && std::abs(sweepAngle) < std::numeric_limits<float>::epsilon()) {
@@ -353,6 +419,7 @@ void SkiaRenderer::StrokeEllipse(
   const Brush& brush,
   const Rect& rect,
   const float thickness) {
+  FrameProfiler::CountDrawCall();
   constexpr auto Epsilon = std::numeric_limits<float>::epsilon();
   if (
     rect.GetWidth() < Epsilon || rect.GetHeight() < Epsilon
@@ -373,10 +440,33 @@ void SkiaRenderer::DrawText(
   const Font& font,
   const std::string_view text,
   const Point& baseline) {
+  FrameProfiler::CountDrawCall();
+  auto paint = brush.as<SkPaint>(this, brushRect);
+  paint.setStyle(SkPaint::Style::kFill_Style);
+  // Not `drawString()`, as that requires a copy of the text in an `SkString`
+  mCanvas->drawSimpleText(
+    text.data(),
+    text.size(),
+    SkTextEncoding::kUTF8,
+    baseline.mX,
+    baseline.mY,
+    font.as<SkFont>(),
+    paint);
+}
+
+void SkiaRenderer::DrawShapedText(
+  const Brush& brush,
+  const Rect& brushRect,
+  const ShapedText& text,
+  const Point& baseline) {
+  FrameProfiler::CountDrawCall();
+  const auto& blob = text.as<sk_sp<SkTextBlob>>();
+  if (!blob) {
+    return;
+  }
   auto paint = brush.as<SkPaint>(this, brushRect);
   paint.setStyle(SkPaint::Style::kFill_Style);
-  mCanvas->drawString(
-    SkString {text}, baseline.mX, baseline.mY, font.as<SkFont>(), paint);
+  mCanvas->drawTextBlob(blob, baseline.mX, baseline.mY, paint);
 }
 
 std::unique_ptr<ImportedTexture> SkiaRenderer::ImportTexture(
@@ -386,6 +476,9 @@ std::unique_ptr<ImportedTexture> SkiaRenderer::ImportTexture(
     kind == ImportedTexture::HandleKind::NTHandle,
     "Only NT HANDLEs are supported when using D3D12 (via Skia)");
   FUI_ASSERT(handle);
+  if (!mNativeDevice.mD3DDevice) {
+    throw std::logic_error("Can't import GPU textures into a raster canvas");
+  }
 
   wil::com_ptr<ID3D12Resource> texture;
   auto ret = std::make_unique<ImportedSkiaTexture>();
@@ -444,6 +537,9 @@ std::unique_ptr<ImportedTexture> SkiaRenderer::ImportTexture(
 std::unique_ptr<ImportedFence> SkiaRenderer::ImportFence(
   const HANDLE handle) const {
   FUI_ASSERT(handle);
+  if (!mNativeDevice.mD3DDevice) {
+    throw std::logic_error("Can't import GPU fences into a raster canvas");
+  }
   auto ret = std::make_unique<ImportedSkiaFence>();
   win32_detail::CheckHResult(mNativeDevice.mD3DDevice->OpenSharedHandle(
     handle, IID_PPV_ARGS(&ret->mSkiaFence.fFence)));
@@ -456,6 +552,7 @@ void SkiaRenderer::DrawTexture(
   ImportedTexture* const rawTexture,
   ImportedFence* const rawFence,
   const uint64_t fenceValue) {
+  FrameProfiler::CountDrawCall();
   FUI_ASSERT(rawTexture);
 #ifdef FUI_DEBUG
 #define IMPL_CAST dynamic_cast
@@ -508,11 +605,15 @@ std::unique_ptr<ImportedTexture> SkiaRenderer::ImportSoftwareBitmap(
   // asynchronously
   auto skiaData = SkData::MakeWithCopy(in.mData.data(), in.mData.size());
   auto ramImage = SkImages::RasterFromData(info, std::move(skiaData), pitch);
-  auto gpuImage = SkImages::TextureFromImage(
-    mNativeDevice.mSkiaContext, std::move(ramImage));
 
   auto ret = std::make_unique<ImportedSkiaTexture>();
-  ret->mSkiaImage = std::move(gpuImage);
+  if (!mNativeDevice.mSkiaContext) {
+    // Raster canvas, e.g. `OffscreenWindow`
+    ret->mSkiaImage = std::move(ramImage);
+    return std::move(ret);
+  }
+  ret->mSkiaImage = SkImages::TextureFromImage(
+    mNativeDevice.mSkiaContext, std::move(ramImage));
   return std::move(ret);
 }
 
@@ -3,8 +3,10 @@
 #pragma once
 
 #include <skia/core/SkCanvas.h>
+#include <skia/core/SkPictureRecorder.h>
 
 #include <FredEmmott/GUI/config.hpp>
+#include <vector>
 
 #include "Renderer.hpp"
 #include "Windows/Win32Direct3D12GaneshWindow.hpp"
@@ -46,6 +48,18 @@ class SkiaRenderer final : public Renderer {
   void Clear(const Color& color) override;
   void PushClipRect(const Rect& rect) override;
   void PopClipRect() override;
+  [[nodiscard]]
+  Rect GetDeviceClipBounds() const override;
+  [[nodiscard]]
+  bool QuickReject(const Rect& rect) const override;
+  [[nodiscard]]
+  Rect GetDeviceBounds(const Rect& rect) const override;
+
+  [[nodiscard]]
+  bool BeginRecording(const Rect& bounds) override;
+  [[nodiscard]]
+  std::unique_ptr<PaintRecording> EndRecording() override;
+  void DrawRecording(const PaintRecording&) override;
 
   void DrawLine(
     const Brush& brush,
@@ -93,6 +107,11 @@ class SkiaRenderer final : public Renderer {
     const Font& font,
     std::string_view text,
     const Point& baseline) override;
+  void DrawShapedText(
+    const Brush& brush,
+    const Rect& brushRect,
+    const ShapedText& text,
+    const Point& baseline) override;
 
   SkCanvas* GetSkCanvas() const noexcept {
     return mCanvas;
@@ -137,6 +156,13 @@ class SkiaRenderer final : public Renderer {
   NativeDevice mNativeDevice {};
   SkCanvas* mCanvas {nullptr};
   std::shared_ptr<GPUCompletionFlag> mFrameCompletionFlag;
+
+  struct Recording {
+    std::unique_ptr<SkPictureRecorder> mRecorder;
+    // The canvas that was active before `BeginRecording()`
+    SkCanvas* mParentCanvas {nullptr};
+  };
+  std::vector<Recording> mRecordings;
 #ifdef FUI_DEBUG
   std::size_t mStackDepth {};
 #endif
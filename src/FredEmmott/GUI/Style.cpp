@@ -5,9 +5,11 @@
 
 #include <FredEmmott/GUI/StaticTheme/Generic.hpp>
 #include <FredEmmott/GUI/assert.hpp>
+#include <atomic>
 #include <mutex>
 
 #include "StaticTheme.hpp"
+#include "StyleCache.hpp"
 
 namespace FredEmmott::GUI {
 
@@ -46,17 +48,12 @@ Style& Style::operator+=(const Style& other) {
   if (mStorage.empty()) {
     mStorage = other.mStorage;
   } else {
-    for (auto&& [key, value]: other.mStorage) {
-      if (!mStorage.contains(key)) {
-        mStorage.emplace(key, value);
-        continue;
-      }
-      VisitStyleProperty(
-        key,
-        [](auto& dest, const auto& src) { dest += src; },
-        mStorage[key],
-        value);
-    }
+    mStorage.merge(
+      other.mStorage,
+      [](const StylePropertyKey key, auto& dest, const auto& src) {
+        VisitStyleProperty(
+          key, [](auto& lhs, const auto& rhs) { lhs += rhs; }, dest, src);
+      });
   }
 
   if (mAnd.empty()) {
@@ -216,4 +213,48 @@ Style Style::BuiltinBaseline() {
   return ret;
 }
 
+uint64_t ImmutableStyle::MakeID() {
+  static std::atomic<uint64_t> sNextID {0};
+  return sNextID++;
+}
+
+std::shared_ptr<const Style> ImmutableStyle::GetCached(
+  const uint64_t matchMask) const {
+  if (!mSharedData) {
+    return nullptr;
+  }
+  return StyleCache::Get().Find({mSharedData->mID, matchMask});
+}
+
+std::shared_ptr<const Style> ImmutableStyle::EmplaceCache(
+  const uint64_t matchMask,
+  Style&& value) {
+  if (!mSharedData) {
+    return std::make_shared<const Style>(std::move(value));
+  }
+  return StyleCache::Get().Emplace(
+    {mSharedData->mID, matchMask}, std::move(value));
+}
+
+void StyleSelectorSet::Add(const Style& style) {
+  const auto addClass = [this](const StyleClass klass) {
+    if (std::ranges::find(mClasses, klass) == mClasses.end()) {
+      mClasses.push_back(klass);
+    }
+  };
+  for (auto&& [selector, rules]: style.mAnd) {
+    if (const auto klass = std::get_if<StyleClass>(&selector)) {
+      addClass(*klass);
+    } else if (const auto negated = std::get_if<NegatedStyleClass>(&selector)) {
+      addClass(negated->mStyleClass);
+    } else if (!std::holds_alternative<std::monostate>(selector)) {
+      mIsCacheable = false;
+    }
+    this->Add(rules);
+  }
+  if (mClasses.size() > 64) {
+    mIsCacheable = false;
+  }
+}
+
 }// namespace FredEmmott::GUI
\ No newline at end of file
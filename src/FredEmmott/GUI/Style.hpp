@@ -5,8 +5,12 @@
 #include <YGEnums.h>
 
 #include <FredEmmott/utility/drop_last_t.hpp>
+#include <FredEmmott/utility/flat_enum_map.hpp>
 #include <FredEmmott/utility/unordered_map.hpp>
+#include <concepts>
+#include <cstdint>
 #include <unordered_set>
+#include <vector>
 
 #include "Brush.hpp"
 #include "Edges.hpp"
@@ -33,14 +37,18 @@ struct Style final {
     FUI_ENUM_STYLE_PROPERTIES(FUI_DECLARE_STYLE_PROPERTY_TYPE)
 #undef FUI_DECLARE_STYLE_PROPERTY_TYPE
   };
-  utility::unordered_map<
+  // Most styles only set a handful of properties; keep those inline so that
+  // copying and merging styles doesn't touch the heap.
+  utility::flat_enum_map<
     StylePropertyKey,
+    style_detail::StylePropertyCount,
     utility::drop_last_t<
       std::variant,
 #define FUI_DECLARE_STYLE_PROPERTY_STORAGE(TYPE, NAME) StyleProperty<TYPE>,
       FUI_ENUM_STYLE_PROPERTY_TYPES(FUI_DECLARE_STYLE_PROPERTY_STORAGE)
 #undef FUI_DECLARE_STYLE_PROPERTY_STORAGE
-        void>>
+        void>,
+    8>
     mStorage;
 
   template <class T>
@@ -201,6 +209,50 @@ inline Style operator+(const Style& lhs, const Style& rhs) noexcept {
   return ret;
 }
 
+/** The classes tested by a style's selectors, including nested `And()`s.
+ *
+ * The result of flattening a style depends only on which of these classes
+ * match, so a bitmask of the matches is a complete cache key that can be
+ * shared between widgets.
+ */
+class StyleSelectorSet final {
+ public:
+  StyleSelectorSet() = default;
+  explicit StyleSelectorSet(const Style& style) {
+    this->Add(style);
+  }
+
+  /// False if the style has selectors that are not classes, e.g. widgets
+  [[nodiscard]]
+  bool IsCacheable() const noexcept {
+    return mIsCacheable;
+  }
+
+  [[nodiscard]]
+  std::size_t GetClassCount() const noexcept {
+    return mClasses.size();
+  }
+
+  /// Bit `i` is set if `matches(classes[i])`; requires `GetClassCount() <= 64`
+  template <std::predicate<StyleClass> TPred>
+  [[nodiscard]]
+  uint64_t GetMatchMask(TPred&& matches) const {
+    uint64_t ret {};
+    for (std::size_t i = 0; i < mClasses.size(); ++i) {
+      if (matches(mClasses[i])) {
+        ret |= uint64_t {1} << i;
+      }
+    }
+    return ret;
+  }
+
+ private:
+  std::vector<StyleClass> mClasses;
+  bool mIsCacheable {true};
+
+  void Add(const Style&);
+};
+
 class ImmutableStyle final {
  public:
   ImmutableStyle() = default;
@@ -213,6 +265,8 @@ class ImmutableStyle final {
         [](auto& prop) { prop.mPriority = StylePropertyPriority::UserAgent; },
         value);
     }
+    mSharedData->mID = MakeID();
+    mSharedData->mSelectors = StyleSelectorSet {mSharedData->mStyle};
   }
 
   operator bool() const noexcept {
@@ -236,30 +290,29 @@ class ImmutableStyle final {
   }
 
   [[nodiscard]]
-  std::optional<Style> GetCached(const std::string& key) const {
-    if (!mSharedData) {
-      return std::nullopt;
-    }
-
-    if (mSharedData->mCache.contains(key)) {
-      return mSharedData->mCache.at(key);
-    }
-    return std::nullopt;
+  const StyleSelectorSet& GetSelectors() const noexcept {
+    static const StyleSelectorSet sEmpty;
+    return mSharedData ? mSharedData->mSelectors : sEmpty;
   }
 
-  void EmplaceCache(std::string_view key, const Style& value) {
-    if (!mSharedData) {
-      return;
-    }
-    mSharedData->mCache.emplace(std::string {key}, value);
-  }
+  /** Flattened styles, keyed by `StyleSelectorSet::GetMatchMask()`.
+   *
+   * These are stored in the shared `StyleCache`; returns nullptr if not
+   * found.
+   */
+  [[nodiscard]]
+  std::shared_ptr<const Style> GetCached(uint64_t matchMask) const;
+  std::shared_ptr<const Style> EmplaceCache(uint64_t matchMask, Style&&);
 
  private:
   struct SharedData {
     Style mStyle;
-    std::unordered_map<std::string, Style> mCache;
+    uint64_t mID {};
+    StyleSelectorSet mSelectors;
   };
   std::shared_ptr<SharedData> mSharedData {};
+
+  static uint64_t MakeID();
 };
 
 }// namespace FredEmmott::GUI
@@ -0,0 +1,79 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include "StyleCache.hpp"
+
+#include "Style.hpp"
+
+namespace FredEmmott::GUI {
+
+std::size_t StyleCache::KeyHash::operator()(const Key& key) const noexcept {
+  // splitmix64 finalizer; the IDs and masks are small and dense, so they
+  // need mixing before use as a hash
+  uint64_t ret = key.mStyleID * 0x9e3779b97f4a7c15ull ^ key.mMatchMask;
+  ret = (ret ^ (ret >> 30)) * 0xbf58476d1ce4e5b9ull;
+  ret = (ret ^ (ret >> 27)) * 0x94d049bb133111ebull;
+  return static_cast<std::size_t>(ret ^ (ret >> 31));
+}
+
+StyleCache& StyleCache::Get() {
+  static StyleCache sInstance;
+  return sInstance;
+}
+
+std::shared_ptr<const Style> StyleCache::Find(const Key& key) {
+  std::unique_lock lock(mMutex);
+  const auto it = mIndex.find(key);
+  if (it == mIndex.end()) {
+    ++mStatistics.mMisses;
+    return nullptr;
+  }
+  ++mStatistics.mHits;
+  mEntries.splice(mEntries.begin(), mEntries, it->second);
+  return it->second->mStyle;
+}
+
+std::shared_ptr<const Style> StyleCache::Emplace(
+  const Key& key,
+  Style&& style) {
+  auto value = std::make_shared<const Style>(std::move(style));
+
+  std::unique_lock lock(mMutex);
+  if (const auto it = mIndex.find(key); it != mIndex.end()) {
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return it->second->mStyle;
+  }
+  mEntries.push_front({key, value});
+  mIndex.emplace(key, mEntries.begin());
+  this->EvictToCapacity();
+  return value;
+}
+
+void StyleCache::SetCapacity(const std::size_t capacity) {
+  std::unique_lock lock(mMutex);
+  mStatistics.mCapacity = capacity;
+  this->EvictToCapacity();
+}
+
+void StyleCache::Clear() {
+  std::unique_lock lock(mMutex);
+  mIndex.clear();
+  mEntries.clear();
+}
+
+StyleCache::Statistics StyleCache::GetStatistics() const {
+  std::unique_lock lock(mMutex);
+  auto ret = mStatistics;
+  ret.mSize = mEntries.size();
+  return ret;
+}
+
+void StyleCache::EvictToCapacity() {
+  while (mEntries.size() > mStatistics.mCapacity) {
+    mIndex.erase(mEntries.back().mKey);
+    mEntries.pop_back();
+    ++mStatistics.mEvictions;
+  }
+}
+
+}// namespace FredEmmott::GUI
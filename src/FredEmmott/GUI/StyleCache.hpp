@@ -0,0 +1,83 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace FredEmmott::GUI {
+
+struct Style;
+
+/** Process-wide cache of flattened `ImmutableStyle`s.
+ *
+ * Entries are immutable and reference-counted, so all widgets with the same
+ * immutable style and matching selectors share a single `Style`. Eviction
+ * only drops the cache's reference, so widgets can keep using an evicted
+ * entry.
+ *
+ * This is thread-safe.
+ */
+class StyleCache final {
+ public:
+  static constexpr std::size_t DefaultCapacity = 4096;
+
+  struct Key {
+    // Shared by copies of an `ImmutableStyle`, but otherwise unique
+    uint64_t mStyleID {};
+    // `StyleSelectorSet::GetMatchMask()`
+    uint64_t mMatchMask {};
+
+    bool operator==(const Key&) const noexcept = default;
+  };
+
+  struct Statistics {
+    uint64_t mHits {};
+    uint64_t mMisses {};
+    uint64_t mEvictions {};
+    std::size_t mSize {};
+    std::size_t mCapacity {};
+  };
+
+  StyleCache(const StyleCache&) = delete;
+  StyleCache& operator=(const StyleCache&) = delete;
+
+  static StyleCache& Get();
+
+  /// Returns nullptr if not found
+  [[nodiscard]]
+  std::shared_ptr<const Style> Find(const Key&);
+  /// If an entry was added by another thread, that entry is returned
+  std::shared_ptr<const Style> Emplace(const Key&, Style&&);
+
+  void SetCapacity(std::size_t);
+  void Clear();
+
+  [[nodiscard]]
+  Statistics GetStatistics() const;
+
+ private:
+  struct KeyHash {
+    std::size_t operator()(const Key&) const noexcept;
+  };
+  struct Entry {
+    Key mKey;
+    std::shared_ptr<const Style> mStyle;
+  };
+
+  mutable std::mutex mMutex;
+  // Most-recently used first
+  std::list<Entry> mEntries;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> mIndex;
+  Statistics mStatistics {.mCapacity = DefaultCapacity};
+
+  StyleCache() = default;
+
+  // Caller must hold `mMutex`
+  void EvictToCapacity();
+};
+
+}// namespace FredEmmott::GUI
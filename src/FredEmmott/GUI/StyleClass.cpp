@@ -4,23 +4,106 @@
 #include "StyleClass.hpp"
 
 #include <FredEmmott/GUI/assert.hpp>
+#include <array>
+#include <atomic>
 #include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
 
 #include "StaticTheme.hpp"
 
 namespace FredEmmott::GUI {
 
-StyleClass StyleClass::Make(std::string_view name) {
-  static std::mutex sClassMutex;
-  static std::list<std::string> sClassNames;
+namespace {
 
-  std::unique_lock lock(sClassMutex);
-  const auto it = std::ranges::find(sClassNames, name);
-  if (it != sClassNames.end()) {
-    return StyleClass {*it};
+struct TransparentStringHash {
+  using is_transparent = void;
+  std::size_t operator()(const std::string_view value) const noexcept {
+    return std::hash<std::string_view> {}(value);
   }
-  sClassNames.emplace_back(std::string {name});
-  return StyleClass {sClassNames.back()};
+};
+
+/* Name -> ID registry.
+ *
+ * Sharded by name hash so that threads creating different classes rarely
+ * contend; `LiteralStyleClass` caches its result, so most classes are only
+ * looked up once.
+ */
+class StyleClassRegistry {
+ public:
+  static StyleClassRegistry& Get() {
+    static StyleClassRegistry sInstance;
+    return sInstance;
+  }
+
+  std::tuple<StyleClass::id_type, std::string_view> Intern(
+    const std::string_view name) {
+    const auto hash = TransparentStringHash {}(name);
+    auto& shard = mShards[hash % mShards.size()];
+    std::unique_lock lock(shard.mMutex);
+    if (const auto it = shard.mIDs.find(name); it != shard.mIDs.end()) {
+      return {it->second, it->first};
+    }
+    // `std::unordered_map` is node-based, so the key is a stable backing
+    // store for the name
+    const auto [it, inserted]
+      = shard.mIDs.emplace(std::string {name}, mNextID++);
+    return {it->second, it->first};
+  }
+
+ private:
+  struct Shard {
+    std::mutex mMutex;
+    std::unordered_map<
+      std::string,
+      StyleClass::id_type,
+      TransparentStringHash,
+      std::equal_to<>>
+      mIDs;
+  };
+
+  std::array<Shard, 16> mShards;
+  std::atomic<StyleClass::id_type> mNextID {0};
+};
+
+}// namespace
+
+StyleClass StyleClass::Make(const std::string_view name) {
+  const auto [id, internedName] = StyleClassRegistry::Get().Intern(name);
+  return StyleClass {id, internedName};
+}
+
+StyleClasses::StyleClasses(const std::initializer_list<StyleClass> classes) {
+  for (auto&& klass: classes) {
+    this->emplace(klass);
+  }
+}
+
+bool StyleClasses::emplace(const StyleClass klass) {
+  const auto id = klass.GetID();
+  const auto it = std::ranges::lower_bound(mIDs, id);
+  if (it != mIDs.end() && *it == id) {
+    return false;
+  }
+  mIDs.insert(it, id);
+  mMask |= GetMaskBit(id);
+  return true;
+}
+
+bool StyleClasses::erase(const StyleClass klass) {
+  const auto id = klass.GetID();
+  const auto it = std::ranges::lower_bound(mIDs, id);
+  if (it == mIDs.end() || *it != id) {
+    return false;
+  }
+  mIDs.erase(it);
+  // Other members may share the bit
+  mMask = 0;
+  for (const auto other: mIDs) {
+    mMask |= GetMaskBit(other);
+  }
+  return true;
 }
 
 StyleClasses& operator+=(StyleClasses& lhs, StyleClass rhs) {
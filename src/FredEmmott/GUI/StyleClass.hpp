@@ -2,19 +2,27 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
-#include <bit>
+#include <algorithm>
+#include <boost/container/small_vector.hpp>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
 #include <optional>
 #include <string_view>
-#include <unordered_set>
 #include <utility>
 
 namespace FredEmmott::GUI {
 struct NegatedStyleClass;
 
+/** An interned style class name.
+ *
+ * Each distinct name has a small, dense ID, so comparisons and hashing are
+ * integer operations.
+ */
 class StyleClass {
-  friend struct std::hash<StyleClass>;
-
  public:
+  using id_type = uint32_t;
+
   StyleClass() = delete;
   StyleClass(const StyleClass&) = default;
   StyleClass(StyleClass&&) = default;
@@ -23,23 +31,73 @@ class StyleClass {
 
   static StyleClass Make(std::string_view name);
 
-  bool operator==(const StyleClass&) const noexcept = default;
+  bool operator==(const StyleClass& other) const noexcept {
+    return mID == other.mID;
+  }
 
   inline NegatedStyleClass operator!() const noexcept;
 
-  uintptr_t AsCacheKey() const noexcept {
-    return std::bit_cast<uintptr_t>(mID.data());
+  [[nodiscard]]
+  id_type GetID() const noexcept {
+    return mID;
   }
 
   std::string_view GetName() const noexcept {
-    return mID;
+    return mName;
   }
 
  private:
-  explicit StyleClass(std::string_view id) : mID(id) {}
-  std::string_view mID {};
+  StyleClass(const id_type id, const std::string_view name)
+    : mID(id),
+      mName(name) {}
+  id_type mID {};
+  std::string_view mName {};
+};
+
+/** A small set of style classes.
+ *
+ * Widgets usually have a handful of classes, so these are stored inline as
+ * sorted IDs. `mMask` has bit `id % 64` set for each member, so most
+ * non-members are rejected by a single bit test.
+ */
+class StyleClasses {
+ public:
+  StyleClasses() = default;
+  StyleClasses(std::initializer_list<StyleClass>);
+
+  [[nodiscard]]
+  bool contains(const StyleClass klass) const noexcept {
+    const auto id = klass.GetID();
+    if ((mMask & GetMaskBit(id)) == 0) {
+      return false;
+    }
+    return std::ranges::binary_search(mIDs, id);
+  }
+
+  /// Returns false if the class was already present
+  bool emplace(StyleClass);
+  /// Returns false if the class was not present
+  bool erase(StyleClass);
+
+  [[nodiscard]]
+  std::size_t size() const noexcept {
+    return mIDs.size();
+  }
+  [[nodiscard]]
+  bool empty() const noexcept {
+    return mIDs.empty();
+  }
+
+  bool operator==(const StyleClasses&) const noexcept = default;
+
+ private:
+  boost::container::small_vector<StyleClass::id_type, 8> mIDs;
+  uint64_t mMask {};
+
+  static constexpr uint64_t GetMaskBit(const StyleClass::id_type id) noexcept {
+    return uint64_t {1} << (id % 64);
+  }
 };
-using StyleClasses = std::unordered_set<StyleClass>;
 StyleClasses operator+(const StyleClasses&, StyleClass);
 StyleClasses& operator+=(StyleClasses&, StyleClass);
 
@@ -93,7 +151,7 @@ LiteralStyleClass(const char (&)[N]) -> LiteralStyleClass<N - 1>;
 template <>
 struct std::hash<FredEmmott::GUI::StyleClass> {
   std::size_t operator()(const FredEmmott::GUI::StyleClass& c) const noexcept {
-    return std::hash<uintptr_t> {}(std::bit_cast<uintptr_t>(c.mID.data()));
+    return std::hash<FredEmmott::GUI::StyleClass::id_type> {}(c.GetID());
   }
 };
 
@@ -0,0 +1,266 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include "TransitionEngine.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "assert.hpp"
+
+namespace FredEmmott::GUI {
+
+template <std::size_t TComponents>
+uint32_t TransitionEngine::Lane<TComponents>::Allocate() {
+  if (!mFree.empty()) {
+    const auto index = mFree.back();
+    mFree.pop_back();
+    return index;
+  }
+
+  const auto index = static_cast<uint32_t>(mProgress.size());
+  mStartTicks.push_back({});
+  mEndTicks.push_back({});
+  mInverseDurations.push_back({});
+  mEasings.push_back(LinearEasing);
+  mProgress.push_back({});
+  for (std::size_t i = 0; i < TComponents; ++i) {
+    mFrom[i].push_back({});
+    mTo[i].push_back({});
+    mValues[i].push_back({});
+  }
+  return index;
+}
+
+template <std::size_t TComponents>
+void TransitionEngine::Lane<TComponents>::Release(const uint32_t index) {
+  FUI_ASSERT(index < mProgress.size());
+  mFree.push_back(index);
+  if (mFree.size() == mProgress.size()) {
+    // Nothing is animating; drop everything so that `Update()` is free until
+    // the next transition starts
+    mStartTicks.clear();
+    mEndTicks.clear();
+    mInverseDurations.clear();
+    mEasings.clear();
+    mProgress.clear();
+    for (std::size_t i = 0; i < TComponents; ++i) {
+      mFrom[i].clear();
+      mTo[i].clear();
+      mValues[i].clear();
+    }
+    mFree.clear();
+    return;
+  }
+
+  // Free slots are still evaluated, as skipping them would add a branch to
+  // every pass; make them as cheap as possible
+  mStartTicks[index] = {};
+  mEndTicks[index] = {};
+  mInverseDurations[index] = {};
+  mEasings[index] = LinearEasing;
+  for (std::size_t i = 0; i < TComponents; ++i) {
+    mFrom[i][index] = {};
+    mTo[i][index] = {};
+  }
+}
+
+template <std::size_t TComponents>
+std::size_t TransitionEngine::Lane<TComponents>::GetActiveCount()
+  const noexcept {
+  return mProgress.size() - mFree.size();
+}
+
+template <std::size_t TComponents>
+void TransitionEngine::Lane<TComponents>::Evaluate(
+  const ticks_type now,
+  const std::vector<EasingFunction>& easings,
+  const std::size_t begin,
+  const std::size_t end) {
+  // These passes are kept branch-free so they can be vectorized
+  {
+    const auto startTicks = mStartTicks.data();
+    const auto endTicks = mEndTicks.data();
+    const auto inverseDurations = mInverseDurations.data();
+    const auto progress = mProgress.data();
+    for (auto i = begin; i < end; ++i) {
+      const auto t = std::clamp(
+        static_cast<float>(now - startTicks[i]) * inverseDurations[i],
+        0.0f,
+        1.0f);
+      progress[i] = (now >= endTicks[i]) ? 1.0f : t;
+    }
+  }
+
+  // Easing functions map 0 to 0 and 1 to 1, except for `Instant`, which is
+  // only meaningful mid-transition
+  for (auto i = begin; i < end; ++i) {
+    const auto easing = mEasings[i];
+    auto& progress = mProgress[i];
+    if (easing == LinearEasing || progress <= 0.0f || progress >= 1.0f) {
+      continue;
+    }
+    progress = easings[easing](progress);
+  }
+
+  const auto progress = mProgress.data();
+  for (std::size_t component = 0; component < TComponents; ++component) {
+    const auto from = mFrom[component].data();
+    const auto to = mTo[component].data();
+    const auto values = mValues[component].data();
+    for (auto i = begin; i < end; ++i) {
+      // Same as `Interpolation::Linear()`
+      values[i] = from[i] + ((to[i] - from[i]) * progress[i]);
+    }
+  }
+}
+
+TransitionEngine::TransitionEngine() {
+  mEasingFunctions.emplace_back(EasingFunctions::Linear {});
+}
+
+TransitionEngine::~TransitionEngine() = default;
+
+void TransitionEngine::Update(const clock::time_point now) {
+  mNow = now;
+  const auto ticks = now.time_since_epoch().count();
+  mFloats.Evaluate(ticks, mEasingFunctions, 0, mFloats.mProgress.size());
+  mColors.Evaluate(ticks, mEasingFunctions, 0, mColors.mProgress.size());
+}
+
+TransitionEngine::easing_index_type TransitionEngine::GetEasingIndex(
+  const EasingFunction& easing) {
+  // There are usually only a handful of distinct curves - mostly the WinUI3
+  // timing constants - so a linear search is fine
+  const auto it = std::ranges::find(mEasingFunctions, easing);
+  if (it != mEasingFunctions.end()) {
+    return static_cast<easing_index_type>(it - mEasingFunctions.begin());
+  }
+  FUI_ASSERT(
+    mEasingFunctions.size() < std::numeric_limits<easing_index_type>::max());
+  mEasingFunctions.push_back(easing);
+  return static_cast<easing_index_type>(mEasingFunctions.size() - 1);
+}
+
+template <std::size_t TComponents>
+TransitionEngine::Handle TransitionEngine::Start(
+  Lane<TComponents>& lane,
+  const ValueType valueType,
+  const Handle previous,
+  const std::array<float, TComponents>& from,
+  const std::array<float, TComponents>& to,
+  const clock::time_point startTime,
+  const clock::time_point endTime,
+  const EasingFunction& easing) {
+  const auto easingIndex = this->GetEasingIndex(easing);
+
+  uint32_t index {};
+  if (previous.GetValueType() == valueType) {
+    index = previous.mIndex;
+  } else {
+    this->Release(previous);
+    index = lane.Allocate();
+  }
+
+  const auto startTicks = startTime.time_since_epoch().count();
+  const auto endTicks = endTime.time_since_epoch().count();
+  lane.mStartTicks[index] = startTicks;
+  lane.mEndTicks[index] = endTicks;
+  lane.mInverseDurations[index] = (endTicks > startTicks)
+    ? (1.0f / static_cast<float>(endTicks - startTicks))
+    : 0.0f;
+  lane.mEasings[index] = easingIndex;
+  for (std::size_t i = 0; i < TComponents; ++i) {
+    lane.mFrom[i][index] = from[i];
+    lane.mTo[i][index] = to[i];
+  }
+
+  lane.Evaluate(
+    mNow.time_since_epoch().count(), mEasingFunctions, index, index + 1);
+  return {valueType, index};
+}
+
+TransitionEngine::Handle TransitionEngine::Start(
+  const Handle previous,
+  const float from,
+  const float to,
+  const clock::time_point startTime,
+  const clock::time_point endTime,
+  const EasingFunction& easing) {
+  return this->Start<1>(
+    mFloats,
+    ValueType::Float,
+    previous,
+    {from},
+    {to},
+    startTime,
+    endTime,
+    easing);
+}
+
+TransitionEngine::Handle TransitionEngine::Start(
+  const Handle previous,
+  const Color& from,
+  const Color& to,
+  const clock::time_point startTime,
+  const clock::time_point endTime,
+  const EasingFunction& easing) {
+  const auto [r0, g0, b0, a0] = from.GetRGBAFTuple();
+  const auto [r1, g1, b1, a1] = to.GetRGBAFTuple();
+  return this->Start<4>(
+    mColors,
+    ValueType::Color,
+    previous,
+    {r0, g0, b0, a0},
+    {r1, g1, b1, a1},
+    startTime,
+    endTime,
+    easing);
+}
+
+void TransitionEngine::Release(const Handle handle) {
+  switch (handle.GetValueType()) {
+    case ValueType::None:
+      return;
+    case ValueType::Float:
+      mFloats.Release(handle.mIndex);
+      return;
+    case ValueType::Color:
+      mColors.Release(handle.mIndex);
+      return;
+  }
+  std::unreachable();
+}
+
+float TransitionEngine::GetProgress(const Handle handle) const {
+  switch (handle.GetValueType()) {
+    case ValueType::None:
+      break;
+    case ValueType::Float:
+      return mFloats.mProgress.at(handle.mIndex);
+    case ValueType::Color:
+      return mColors.mProgress.at(handle.mIndex);
+  }
+  throw std::logic_error("Can't get the progress of an invalid transition");
+}
+
+float TransitionEngine::GetFloat(const Handle handle) const {
+  FUI_ASSERT(handle.GetValueType() == ValueType::Float);
+  return mFloats.mValues[0].at(handle.mIndex);
+}
+
+Color TransitionEngine::GetColor(const Handle handle) const {
+  FUI_ASSERT(handle.GetValueType() == ValueType::Color);
+  const auto& values = mColors.mValues;
+  const auto i = handle.mIndex;
+  return Color::Constant::FromRGBA128F(
+    values[0].at(i), values[1].at(i), values[2].at(i), values[3].at(i));
+}
+
+std::size_t TransitionEngine::GetActiveCount() const noexcept {
+  return mFloats.GetActiveCount() + mColors.GetActiveCount();
+}
+
+}// namespace FredEmmott::GUI
@@ -0,0 +1,168 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "Color.hpp"
+#include "EasingFunctions.hpp"
+
+namespace FredEmmott::GUI {
+
+/** Per-window evaluation of all active style transitions.
+ *
+ * Transitions are stored in structure-of-arrays form, with separate storage
+ * for each value type. `Update()` samples the clock once per frame, then
+ * evaluates timing, easing, and interpolation as separate passes over
+ * contiguous arrays; only non-linear easing functions are evaluated
+ * per-element.
+ *
+ * Widgets keep a `Handle`, and read the current value while computing their
+ * styles.
+ */
+class TransitionEngine final {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  enum class ValueType : uint8_t {
+    None,
+    Float,
+    Color,
+  };
+
+  class Handle {
+   public:
+    constexpr Handle() = default;
+
+    [[nodiscard]]
+    constexpr bool IsValid() const noexcept {
+      return mValueType != ValueType::None;
+    }
+
+    [[nodiscard]]
+    constexpr ValueType GetValueType() const noexcept {
+      return mValueType;
+    }
+
+   private:
+    friend class TransitionEngine;
+
+    constexpr Handle(const ValueType valueType, const uint32_t index)
+      : mValueType(valueType),
+        mIndex(index) {}
+
+    ValueType mValueType {ValueType::None};
+    uint32_t mIndex {};
+  };
+
+  TransitionEngine();
+  ~TransitionEngine();
+
+  TransitionEngine(const TransitionEngine&) = delete;
+  TransitionEngine& operator=(const TransitionEngine&) = delete;
+
+  /// Evaluate every active transition at `now`
+  void Update(clock::time_point now);
+
+  /// The time of the last `Update()`
+  [[nodiscard]]
+  clock::time_point GetNow() const noexcept {
+    return mNow;
+  }
+
+  /** Start a transition, reusing `previous`'s storage if possible.
+   *
+   * The value is available immediately, evaluated at `GetNow()`.
+   */
+  [[nodiscard]]
+  Handle Start(
+    Handle previous,
+    float from,
+    float to,
+    clock::time_point startTime,
+    clock::time_point endTime,
+    const EasingFunction&);
+  [[nodiscard]]
+  Handle Start(
+    Handle previous,
+    const Color& from,
+    const Color& to,
+    clock::time_point startTime,
+    clock::time_point endTime,
+    const EasingFunction&);
+
+  void Release(Handle);
+
+  /// The eased progress, from 0 to 1; valid for any value type
+  [[nodiscard]]
+  float GetProgress(Handle) const;
+  [[nodiscard]]
+  float GetFloat(Handle) const;
+  [[nodiscard]]
+  Color GetColor(Handle) const;
+
+  [[nodiscard]]
+  std::size_t GetActiveCount() const noexcept;
+
+ private:
+  using ticks_type = clock::rep;
+  using easing_index_type = uint16_t;
+  // `mEasingFunctions[LinearEasing]` is the identity
+  static constexpr easing_index_type LinearEasing = 0;
+
+  template <std::size_t TComponents>
+  struct Lane {
+    std::vector<ticks_type> mStartTicks;
+    std::vector<ticks_type> mEndTicks;
+    // 0 for instant transitions
+    std::vector<float> mInverseDurations;
+    std::vector<easing_index_type> mEasings;
+    // Eased; 0 before the start time, and 1 after the end time
+    std::vector<float> mProgress;
+    // Component-major, e.g. all reds, then all greens
+    std::array<std::vector<float>, TComponents> mFrom;
+    std::array<std::vector<float>, TComponents> mTo;
+    std::array<std::vector<float>, TComponents> mValues;
+
+    std::vector<uint32_t> mFree;
+
+    [[nodiscard]]
+    uint32_t Allocate();
+    void Release(uint32_t);
+    [[nodiscard]]
+    std::size_t GetActiveCount() const noexcept;
+
+    void Evaluate(
+      ticks_type now,
+      const std::vector<EasingFunction>& easings,
+      std::size_t begin,
+      std::size_t end);
+  };
+
+  clock::time_point mNow {};
+  std::vector<EasingFunction> mEasingFunctions;
+
+  Lane<1> mFloats;
+  // RGBA
+  Lane<4> mColors;
+
+  [[nodiscard]]
+  easing_index_type GetEasingIndex(const EasingFunction&);
+
+  template <std::size_t TComponents>
+  [[nodiscard]]
+  Handle Start(
+    Lane<TComponents>& lane,
+    ValueType valueType,
+    Handle previous,
+    const std::array<float, TComponents>& from,
+    const std::array<float, TComponents>& to,
+    clock::time_point startTime,
+    clock::time_point endTime,
+    const EasingFunction&);
+};
+
+}// namespace FredEmmott::GUI
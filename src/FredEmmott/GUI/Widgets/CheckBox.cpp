@@ -198,6 +198,10 @@ class CheckBoxGlyph final : public Widget {
   void Tick(const std::chrono::steady_clock::time_point& now) override;
   void PaintOwnContent(Renderer*, const Rect&, const Style&) const override;
   [[nodiscard]]
+  bool HasVolatilePaint() const noexcept override {
+    return true;
+  }
+  [[nodiscard]]
   FrameRateRequirement GetFrameRateRequirement() const noexcept override {
     if (mAnimationFinishedAt > std::chrono::steady_clock::now()) {
       return FrameRateRequirement::SmoothAnimation {};
@@ -246,6 +250,7 @@ void CheckBoxGlyph::Tick(const std::chrono::steady_clock::time_point& now) {
     mTickedAt = now;
     mAnimationFinishedAt
       = now + StaticTheme::Common::ControlFastAnimationDuration;
+    this->InvalidateFrameRateRequirement();
   }
 }
 
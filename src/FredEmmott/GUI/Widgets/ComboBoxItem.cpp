@@ -130,6 +130,7 @@ Widget::EventHandlerResult ComboBoxItem::OnMouseButtonPress(
   const MouseEvent& e) {
   if (IsChecked()) {
     mSelectionPill.Transition(SelectionPill::State::SelectedPressed);
+    this->InvalidateFrameRateRequirement();
   }
   return Button::OnMouseButtonPress(e);
 }
@@ -141,6 +142,7 @@ void ComboBoxItem::OnMouseEnter(const MouseEvent& e) {
     && (e.mButtons == MouseButton::Left)) {
     // WinUI3 doesn't do this, but it feels better like this :)
     mSelectionPill.Transition(SelectionPill::State::SelectedPressed);
+    this->InvalidateFrameRateRequirement();
   }
 }
 
@@ -148,6 +150,7 @@ void ComboBoxItem::OnMouseLeave(const MouseEvent& e) {
   Button::OnMouseLeave(e);
   if (mSelectionPill.GetState() == SelectionPill::State::SelectedPressed) {
     mSelectionPill.Transition(SelectionPill::State::SelectedReleased);
+    this->InvalidateFrameRateRequirement();
   }
 }
 
@@ -42,6 +42,10 @@ class ComboBoxItem : public Button, public ISelectionItem {
 
  protected:
   void PaintOwnContent(Renderer*, const Rect&, const Style&) const override;
+  [[nodiscard]]
+  bool HasVolatilePaint() const noexcept override {
+    return true;
+  }
   EventHandlerResult OnMouseButtonPress(const MouseEvent&) override;
   void OnMouseEnter(const MouseEvent&) override;
   void OnMouseLeave(const MouseEvent&) override;
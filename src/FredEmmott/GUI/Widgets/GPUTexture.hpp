@@ -27,6 +27,10 @@ class GPUTexture final : public Widget {
  protected:
   void PaintOwnContent(Renderer*, const Rect&, const Style& style)
     const override;
+  [[nodiscard]]
+  bool HasVolatilePaint() const noexcept override {
+    return true;
+  }
 
  private:
   ImportedTexture::HandleKind mTextureHandleKind {};
@@ -0,0 +1,150 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include "ItemsRepeater.hpp"
+
+#include <Yoga.h>
+
+#include <FredEmmott/GUI/assert.hpp>
+#include <cmath>
+
+#include "ScrollView.hpp"
+
+namespace FredEmmott::GUI::Widgets {
+
+namespace {
+
+constexpr LiteralStyleClass ItemsRepeaterStyleClass("ItemsRepeater");
+constexpr LiteralStyleClass RealizedItemsStyleClass(
+  "ItemsRepeater/RealizedItems");
+
+// Realize items within this fraction of the viewport height above and below
+// the viewport, so that we're not showing blank space while scrolling
+constexpr float OverscanViewports = 0.5f;
+
+// Used if there's no layout yet
+constexpr float DefaultViewportHeight = 1024.f;
+
+auto& ItemsRepeaterStyle() {
+  static const ImmutableStyle ret {
+    Style().FlexShrink(0).Position(PositionType::Relative),
+  };
+  return ret;
+}
+
+auto& RealizedItemsStyle() {
+  static const ImmutableStyle ret {
+    Style()
+      .FlexDirection(FlexDirection::Column)
+      .Left(0.f)
+      .Position(PositionType::Absolute)
+      .Right(0.f)
+      .Top(0.f),
+  };
+  return ret;
+}
+
+}// namespace
+
+ItemsRepeater::ItemsRepeater(Window* const window)
+  : Widget(window, ItemsRepeaterStyleClass, ItemsRepeaterStyle()) {
+  this->SetStructuralChildren({
+    mRealizedItems = new Widget(
+      window, RealizedItemsStyleClass, RealizedItemsStyle()),
+  });
+  this->SetStructuralParentForLogicalChildren(mRealizedItems);
+}
+
+ItemsRepeater::~ItemsRepeater() = default;
+
+ScrollView* ItemsRepeater::FindScrollView() const {
+  for (auto it = this->GetStructuralParentOrNull(); it;
+       it = it->GetStructuralParentOrNull()) {
+    if (const auto scrollView = dynamic_cast<ScrollView*>(it)) {
+      return scrollView;
+    }
+  }
+  return nullptr;
+}
+
+void ItemsRepeater::UpdateEstimatedItemHeight(const float estimate) {
+  float total {};
+  std::size_t count {};
+  for (auto&& item: mRealizedItems->GetStructuralChildren()) {
+    const auto height = YGNodeLayoutGetHeight(item->GetLayoutNode());
+    if (std::isnan(height) || height <= 0) {
+      continue;
+    }
+    total += height;
+    ++count;
+  }
+
+  if (count) {
+    mItemHeight = total / count;
+  } else if (mItemSizing != ItemSizing::Estimated || mItemHeight <= 0) {
+    mItemHeight = estimate;
+  }
+}
+
+ItemsRepeater::RealizedRange ItemsRepeater::Update(
+  const std::size_t itemCount,
+  const ItemSizing sizing,
+  const float itemHeight) {
+  FUI_ASSERT(itemHeight > 0, "Item height (or estimate) must be positive");
+
+  if (sizing == ItemSizing::Fixed) {
+    mItemHeight = itemHeight;
+  } else {
+    this->UpdateEstimatedItemHeight(itemHeight);
+  }
+  mItemSizing = sizing;
+  mItemCount = itemCount;
+
+  const auto scrollView = this->FindScrollView();
+  if (!scrollView) {
+    mHasViewport = true;
+    mUpdatesWithoutViewport = 0;
+    // Every item is realized, so every item needs its own slot
+    mSlotCount = std::max(mSlotCount, itemCount);
+    this->AddMutableStyles(Style().Height(mItemHeight * itemCount));
+    return {0, itemCount};
+  }
+
+  // The viewport, in our coordinate space
+  float viewportTop = -this->GetTopLeftCanvasPoint(scrollView).mY;
+  float viewportHeight = scrollView->GetSize().mHeight;
+  mHasViewport = !(std::isnan(viewportHeight) || viewportHeight <= 0);
+  mUpdatesWithoutViewport = mHasViewport ? 0 : (mUpdatesWithoutViewport + 1);
+  if (!mHasViewport) {
+    viewportTop = 0;
+    viewportHeight = DefaultViewportHeight;
+  }
+
+  const auto overscan = viewportHeight * OverscanViewports;
+  const auto top = std::max(0.f, viewportTop - overscan);
+  const auto bottom = std::max(0.f, viewportTop + viewportHeight + overscan);
+
+  const auto begin = std::min(
+    itemCount, static_cast<std::size_t>(std::floor(top / mItemHeight)));
+  const auto end = std::clamp(
+    static_cast<std::size_t>(std::ceil(bottom / mItemHeight)),
+    begin,
+    itemCount);
+
+  // Only ever grow this; if it changed every time the realized count changed,
+  // every item would get a new ID, and nothing would be recycled
+  mSlotCount = std::max(mSlotCount, end - begin);
+
+  this->AddMutableStyles(Style().Height(mItemHeight * itemCount));
+  mRealizedItems->AddMutableStyles(Style().Top(mItemHeight * begin));
+
+  return {begin, end};
+}
+
+Widget::id_type ItemsRepeater::GetItemID(const std::size_t index) const noexcept {
+  // Distinct IDs so that switching modes doesn't reuse fixed-height items
+  const id_type sizingBit = (mItemSizing == ItemSizing::Fixed) ? 0 : 1;
+  return ((index % mSlotCount) << 1) | sizingBit;
+}
+
+}// namespace FredEmmott::GUI::Widgets
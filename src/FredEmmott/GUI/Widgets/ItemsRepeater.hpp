@@ -0,0 +1,91 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "Widget.hpp"
+
+namespace FredEmmott::GUI::Widgets {
+
+class ScrollView;
+
+/** Lays out a (potentially huge) list of items, but only realizes the ones
+ * that are in, or near, the viewport of the nearest `ScrollView` ancestor.
+ *
+ * The repeater reserves space for every item, and positions the realized
+ * items within that space; with `ItemSizing::Estimated`, the reserved space
+ * per item is the average height of the items realized in the previous frame.
+ *
+ * If there is no `ScrollView` ancestor, all items are realized.
+ */
+class ItemsRepeater final : public Widget {
+ public:
+  enum class ItemSizing {
+    Fixed,
+    Estimated,
+  };
+
+  struct RealizedRange {
+    std::size_t mBegin {};
+    std::size_t mEnd {};
+  };
+
+  explicit ItemsRepeater(Window*);
+  ~ItemsRepeater() override;
+
+  /** Update the item count and sizing, and return the items to realize.
+   *
+   * Uses the layout and scroll position from the previous frame.
+   */
+  RealizedRange Update(std::size_t itemCount, ItemSizing, float itemHeight);
+
+  /** A sibling ID for the item container.
+   *
+   * These are reused as items scroll in and out of view, so that widgets are
+   * recycled instead of destroyed and recreated.
+   */
+  [[nodiscard]]
+  id_type GetItemID(std::size_t index) const noexcept;
+
+  [[nodiscard]]
+  ItemSizing GetItemSizing() const noexcept {
+    return mItemSizing;
+  }
+
+  [[nodiscard]]
+  float GetItemHeight() const noexcept {
+    return mItemHeight;
+  }
+
+  /// False if we don't yet have a layout for the viewport
+  [[nodiscard]]
+  bool HasViewport() const noexcept {
+    return mHasViewport;
+  }
+
+  /** True if the realized range was a guess, and one more frame is needed.
+   *
+   * Only true for the first update without a viewport; if the `ScrollView`
+   * is collapsed or hidden, it may never have a layout.
+   */
+  [[nodiscard]]
+  bool NeedsAdditionalFrame() const noexcept {
+    return mUpdatesWithoutViewport == 1;
+  }
+
+ private:
+  Widget* mRealizedItems {};
+
+  std::size_t mItemCount {};
+  ItemSizing mItemSizing {ItemSizing::Fixed};
+  float mItemHeight {};
+  std::size_t mSlotCount {1};
+  bool mHasViewport {false};
+  // Consecutive calls to `Update()` without a viewport
+  std::size_t mUpdatesWithoutViewport {};
+
+  [[nodiscard]]
+  ScrollView* FindScrollView() const;
+  void UpdateEstimatedItemHeight(float estimate);
+};
+
+}// namespace FredEmmott::GUI::Widgets
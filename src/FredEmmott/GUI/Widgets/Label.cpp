@@ -5,7 +5,9 @@
 
 #include <Yoga.h>
 
+#include <FredEmmott/GUI/FrameProfiler.hpp>
 #include <FredEmmott/GUI/StaticTheme.hpp>
+#include <bit>
 
 using namespace FredEmmott::utility;
 
@@ -37,11 +39,12 @@ Label* Label::SetText(std::string_view text) {
     return this;
   }
   mText = std::string {text};
-  mCachedMeasurement.reset();
+  this->InvalidatePaint();
 
   if (!mFont) {
     return this;
   }
+  this->UpdateShapedText();
 
   // Check before calling `YGNodeMarkDirty()` as this will mark
   // all ancestor nodes as dirty, even if this node layout/size doesn't change
@@ -51,8 +54,9 @@ Label* Label::SetText(std::string_view text) {
        + YGNodeLayoutGetPadding(yoga, YGEdgeLeft)
        + YGNodeLayoutGetPadding(yoga, YGEdgeRight)
        + YGNodeLayoutGetBorder(yoga, YGEdgeRight));
-  if (std::abs(mFont.MeasureTextWidth(mText) - availableWidth) > 1.0) {
+  if (std::abs(mShapedText.GetWidth() - availableWidth) > 1.0) {
     YGNodeMarkDirty(this->GetLayoutNode());
+    FrameProfiler::Count(WidgetCounter::YogaNodesDirtied, this);
   }
 
   return this;
@@ -88,22 +92,18 @@ void Label::PaintOwnContent(
   switch (style.TextAlign().value_or(TextAlign::Left)) {
     case TextAlign::Left:
       break;
-    case TextAlign::Center: {
-      const auto textWidth = mFont.MeasureTextWidth(mText);
-      baseline.mX += (rect.GetWidth() - textWidth) / 2;
+    case TextAlign::Center:
+      baseline.mX += (rect.GetWidth() - mShapedText.GetWidth()) / 2;
       break;
-    }
-    case TextAlign::Right: {
-      const auto textWidth = mFont.MeasureTextWidth(mText);
-      baseline.mX = (rect.GetRight() - textWidth);
+    case TextAlign::Right:
+      baseline.mX = (rect.GetRight() - mShapedText.GetWidth());
       break;
-    }
   }
 
   FUI_ASSERT(!std::isnan(rect.mSize.mWidth));
   FUI_ASSERT(!std::isnan(rect.mSize.mHeight));
 
-  renderer->DrawText(style.Color().value(), rect, mFont, mText, baseline);
+  renderer->DrawShapedText(style.Color().value(), rect, mShapedText, baseline);
 }
 
 Widget::ComputedStyleFlags Label::OnComputedStyleChange(
@@ -111,8 +111,9 @@ Widget::ComputedStyleFlags Label::OnComputedStyleChange(
   StateFlags) {
   if (mFont != style.Font()) {
     mFont = style.Font().value();
-    mCachedMeasurement.reset();
+    this->UpdateShapedText();
     YGNodeMarkDirty(this->GetLayoutNode());
+    FrameProfiler::Count(WidgetCounter::YogaNodesDirtied, this);
   }
 
   return ComputedStyleFlags::Empty;
@@ -124,20 +125,17 @@ YGSize Label::Measure(
   [[maybe_unused]] YGMeasureMode widthMode,
   [[maybe_unused]] float height,
   [[maybe_unused]] YGMeasureMode heightMode) {
-  auto& self = *static_cast<Label*>(FromYogaNode(node));
-
-  if (self.mCachedMeasurement) {
-    return std::bit_cast<YGSize>(*self.mCachedMeasurement);
-  }
-
-  const auto& font = self.mFont;
-  const auto& text = self.mText;
-
-  const auto tw = font.MeasureTextWidth(text);
-  const auto metrics = font.GetMetrics();
+  const auto& self = *static_cast<Label*>(FromYogaNode(node));
+  const auto metrics = self.mFont.GetMetrics();
+  return std::bit_cast<YGSize>(Size {
+    self.mShapedText.GetWidth(),
+    metrics.mDescent - metrics.mAscent,
+  });
+}
 
-  self.mCachedMeasurement.emplace(tw, metrics.mDescent - metrics.mAscent);
-  return std::bit_cast<YGSize>(*self.mCachedMeasurement);
+void Label::UpdateShapedText() {
+  mShapedText = mFont.ShapeText(mText);
+  FrameProfiler::Count(WidgetCounter::ParagraphsRebuilt, this);
 }
 
 }// namespace FredEmmott::GUI::Widgets
\ No newline at end of file
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include <FredEmmott/GUI/ShapedText.hpp>
 #include <FredEmmott/GUI/Style.hpp>
 
 #include "Widget.hpp"
@@ -33,8 +34,10 @@ class Label final : public Widget {
  private:
   std::string mText;
   Font mFont;
+  // Shaped when the text or font changes, not when painting
+  ShapedText mShapedText;
 
-  std::optional<Size> mCachedMeasurement;
+  void UpdateShapedText();
 
   static YGSize Measure(
     const YGNode* node,
@@ -53,6 +53,7 @@ MenuFlyoutItem::~MenuFlyoutItem() = default;
 
 void MenuFlyoutItem::SetGlyph(const std::string_view glyph) {
   mGlyph = glyph;
+  this->InvalidatePaint();
 }
 
 void MenuFlyoutItem::SetLabel(const std::string_view label) {
@@ -113,6 +113,7 @@ Widget::EventHandlerResult NavigationViewButton::OnMouseButtonPress(
     mFromScale = 1.0f;
     mToScale = 0.5f;
     mAnimationStart = std::chrono::steady_clock::now();
+    this->InvalidateFrameRateRequirement();
   }
   return Widget::OnMouseButtonPress(e);
 }
@@ -126,6 +127,7 @@ Widget::EventHandlerResult NavigationViewButton::OnMouseButtonRelease(
     mFromScale = 0.5f;
     mToScale = 1.0f;
     mAnimationStart = std::chrono::steady_clock::now();
+    this->InvalidateFrameRateRequirement();
   }
   return Widget::OnMouseButtonRelease(e);
 }
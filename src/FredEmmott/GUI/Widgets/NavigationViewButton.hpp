@@ -15,6 +15,10 @@ class NavigationViewButton : public Widget, public IInvocable {
 
  protected:
   void PaintOwnContent(Renderer*, const Rect&, const Style&) const override;
+  [[nodiscard]]
+  bool HasVolatilePaint() const noexcept override {
+    return true;
+  }
 
   ComputedStyleFlags OnComputedStyleChange(const Style& style, StateFlags state)
     final;
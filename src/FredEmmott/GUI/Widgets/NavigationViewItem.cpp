@@ -68,15 +68,16 @@ void NavigationViewItem::Select() {
 
   const auto selfIt = std::ranges::find(peers, this);
   FUI_ASSERT(selfIt != peers.end());
+  const auto previous = CastSelectionSibling<NavigationViewItem>(*selectedPeer);
   if (selfIt < selectedPeer) {
     mSelectionPill.Transition(PillState::GainingSelectionFromBelow);
-    CastSelectionSibling<NavigationViewItem>(*selectedPeer)
-      ->mSelectionPill.Transition(PillState::LosingSelectionToAbove);
+    previous->mSelectionPill.Transition(PillState::LosingSelectionToAbove);
   } else {
     mSelectionPill.Transition(PillState::GainingSelectionFromAbove);
-    CastSelectionSibling<NavigationViewItem>(*selectedPeer)
-      ->mSelectionPill.Transition(PillState::LosingSelectionToBelow);
+    previous->mSelectionPill.Transition(PillState::LosingSelectionToBelow);
   }
+  this->InvalidateFrameRateRequirement();
+  previous->InvalidateFrameRateRequirement();
 }
 
 ISelectionContainer* NavigationViewItem::GetSelectionContainer()
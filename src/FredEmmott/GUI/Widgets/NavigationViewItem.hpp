@@ -52,6 +52,10 @@ class NavigationViewItem : public Widget, public ISelectionItem {
   EventHandlerResult OnClick(const MouseEvent&) override;
   FrameRateRequirement GetFrameRateRequirement() const noexcept override;
   void PaintOwnContent(Renderer*, const Rect&, const Style&) const override;
+  [[nodiscard]]
+  bool HasVolatilePaint() const noexcept override {
+    return true;
+  }
 
  private:
   bool mWasSelected = false;
@@ -22,11 +22,17 @@ void NavigationViewSettingsItem::Tick(
     return;
   }
 
+  // Static so that the curves' lookup tables are built at compile time,
+  // rather than every tick
+  static constexpr EasingFunctions::CubicBezier OnPressEase {
+    0.167f, 0.167f, 1, 1};
+  static constexpr EasingFunctions::CubicBezier OnReleaseEase {0, 0, 0, 1};
+
   struct Params {
     float mStartValue {};
     float mEndValue {};
     std::chrono::milliseconds mDuration {};
-    std::array<float, 4> mBezierPoints {};
+    const EasingFunctions::CubicBezier* mEase {nullptr};
   };
   const auto params = [](const AnimationState state) constexpr -> Params {
     // These are based on the generated C++ in WinUI3, which in turn is based
@@ -39,14 +45,14 @@ void NavigationViewSettingsItem::Tick(
           0,
           -20,
           std::chrono::milliseconds {125},
-          {0.167, 0.167, 1, 1},
+          &OnPressEase,
         };
       case OnRelease:
         return {
           -20,
           360,
           std::chrono::milliseconds {483},
-          {0, 0, 0, 1},
+          &OnReleaseEase,
         };
     }
     std::unreachable();
@@ -63,9 +69,8 @@ void NavigationViewSettingsItem::Tick(
   const auto t
     = std::chrono::duration_cast<std::chrono::duration<float>>(elapsed)
     / params.mDuration;
-  const auto ease = EasingFunctions::CubicBezier(params.mBezierPoints);
-  const auto degrees
-    = params.mStartValue + (ease(t) * (params.mEndValue - params.mStartValue));
+  const auto degrees = params.mStartValue
+    + ((*params.mEase)(t) * (params.mEndValue - params.mStartValue));
   this->SetIconRotation(degrees);
 }
 
@@ -88,6 +93,7 @@ Widget::EventHandlerResult NavigationViewSettingsItem::OnMouseButtonPress(
     } else {
       mNextAnimationState = AnimationState::OnPress;
     }
+    this->InvalidateFrameRateRequirement();
   }
 
   return NavigationViewItem::OnMouseButtonPress(e);
@@ -104,6 +110,7 @@ Widget::EventHandlerResult NavigationViewSettingsItem::OnMouseButtonRelease(
     } else {
       mNextAnimationState = AnimationState::OnRelease;
     }
+    this->InvalidateFrameRateRequirement();
   }
   return NavigationViewItem::OnMouseButtonRelease(e);
 }
@@ -24,7 +24,11 @@ PopupWindow::PopupWindow(Window* const window)
       LiteralStyleClass {"PopupWindow"},
       InvisibleStyle(),
       {PseudoClasses::LayoutOrphan}),
-    mWindow(window->CreatePopup()) {}
+    mWindow(window->CreatePopup()) {
+  // Popups are updated as part of our window's frame, so it needs to wake
+  // up for them
+  mWindow->GetFrameScheduler()->SetParent(window->GetFrameScheduler(), this);
+}
 
 PopupWindow::~PopupWindow() = default;
 
@@ -22,7 +22,9 @@ auto& ProgressRingStyle() {
 
 ProgressRing::ProgressRing(Window* const window, const Kind kind)
   : Widget(window, ProgressRingStyleClass, ProgressRingStyle()),
-    mKind(kind) {}
+    mKind(kind) {
+  this->InvalidateFrameRateRequirement();
+}
 
 void ProgressRing::SetRange(const float minimum, const float maximum) {
   if (
@@ -33,6 +35,7 @@ void ProgressRing::SetRange(const float minimum, const float maximum) {
   mMinimum = minimum;
   mMaximum = maximum;
   mValue = std::clamp(mValue, minimum, maximum);
+  this->InvalidatePaint();
 }
 
 void ProgressRing::SetValue(const float value) {
@@ -43,10 +46,13 @@ void ProgressRing::SetValue(const float value) {
     throw std::out_of_range("Value must be between minimum and maximum");
   }
   mValue = value;
+  this->InvalidatePaint();
 }
 
 void ProgressRing::SetIsActive(const bool value) {
   mIsActive = value;
+  this->InvalidatePaint();
+  this->InvalidateFrameRateRequirement();
 }
 
 void ProgressRing::PaintOwnContent(
@@ -22,6 +22,10 @@ class ProgressRing final : public Widget {
 
  protected:
   void PaintOwnContent(Renderer*, const Rect&, const Style&) const override;
+  [[nodiscard]]
+  bool HasVolatilePaint() const noexcept override {
+    return mKind == Kind::Indeterminate && mIsActive;
+  }
   FrameRateRequirement GetFrameRateRequirement() const noexcept override;
 
  private:
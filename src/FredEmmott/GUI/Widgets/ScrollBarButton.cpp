@@ -76,6 +76,7 @@ Widget::EventHandlerResult ScrollBarButton::OnMouseButtonPress(
   }
   mNextTick = std::chrono::steady_clock::now()
     + SystemSettings::Get().GetKeyboardRepeatDelay();
+  this->InvalidateFrameRateRequirement();
   return EventHandlerResult::StopPropagation;
 }
 
@@ -8,6 +8,7 @@
 #include <FredEmmott/GUI/Widgets/ScrollView.hpp>
 #include <FredEmmott/GUI/Widgets/WidgetList.hpp>
 
+#include "FredEmmott/GUI/FrameProfiler.hpp"
 #include "FredEmmott/GUI/SystemSettings.hpp"
 #include "FredEmmott/GUI/assert.hpp"
 #include "FredEmmott/GUI/detail/widget_detail.hpp"
@@ -209,7 +210,7 @@ void ScrollView::UpdateScrollBars(const Size& containerSize) const {
     mVerticalScrollBar->AddMutableStyles(Style().Display(Display::None));
   }
 
-  const auto inheritable = GetComputedStyle().InheritableValues();
+  const auto inheritable = this->GetChildInheritedStyles();
   mHorizontalScrollBar->ComputeStyles(inheritable);
   mVerticalScrollBar->ComputeStyles(inheritable);
   FUI_ASSERT(
@@ -234,12 +235,12 @@ void ScrollView::UpdateScrollBars(const Size& containerSize) const {
   mContentInner->ComputeStyles(inheritable);
 }
 
+void ScrollView::OnLayoutChanged() {
+  this->UpdateLayout();
+}
+
 void ScrollView::PaintChildren(Renderer* renderer) const {
   const auto node = this->GetLayoutNode();
-  if (YGNodeGetHasNewLayout(node)) {
-    this->UpdateLayout();
-    YGNodeSetHasNewLayout(node, false);
-  }
   const auto w = YGNodeLayoutGetWidth(node);
   const auto h = YGNodeLayoutGetHeight(node);
   const auto clipTo = renderer->ScopedClipRect(Size {w, h});
@@ -249,6 +250,21 @@ void ScrollView::PaintChildren(Renderer* renderer) const {
   mVerticalScrollBar->Paint(renderer);
 }
 
+void ScrollView::CollectChildPaintDamage(Renderer* renderer, Rect* damage) {
+  const auto node = this->GetLayoutNode();
+  const auto clipTo = renderer->ScopedClipRect(
+    Size {YGNodeLayoutGetWidth(node), YGNodeLayoutGetHeight(node)});
+
+  mContentInner->CollectPaintDamage(renderer, damage);
+  mHorizontalScrollBar->CollectPaintDamage(renderer, damage);
+  mVerticalScrollBar->CollectPaintDamage(renderer, damage);
+}
+
+Rect ScrollView::GetChildInkBounds() const {
+  // Clipped to our box by `PaintChildren()`
+  return {};
+}
+
 Widget::EventHandlerResult ScrollView::OnMouseVerticalWheel(
   const MouseEvent& e) {
   const auto delta = std::get<MouseEvent::VerticalWheelEvent>(e.mDetail).mDelta;
@@ -319,9 +335,11 @@ bool ScrollView::IsScrollBarVisible(
 }
 
 void ScrollView::OnInnerContentDirty(YGNodeConstRef node) {
+  Widget::OnLayoutNodeDirtied(node);
   auto& self = *FromYogaNode(node)->GetStructuralParent<ScrollView>();
   self.mDirtyInner = true;
   YGNodeMarkDirty(self.mContentOuter->GetLayoutNode());
+  FrameProfiler::Count(WidgetCounter::YogaNodesDirtied, self.mContentOuter);
 }
 
 YGSize ScrollView::MeasureOuterContent(
@@ -29,7 +29,11 @@ class ScrollView final : public Widget {
   void EnsureVisible(const Rect&) override;
 
  protected:
+  void OnLayoutChanged() override;
   void PaintChildren(Renderer* renderer) const override;
+  void CollectChildPaintDamage(Renderer*, Rect* damage) override;
+  [[nodiscard]]
+  Rect GetChildInkBounds() const override;
   EventHandlerResult OnMouseVerticalWheel(const MouseEvent&) override;
 
  private:
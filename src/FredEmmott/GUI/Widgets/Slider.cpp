@@ -345,6 +345,7 @@ void Slider::SetThumbState(const uint8_t raw) {
       now,
       now,
       now + SliderInnerThumbScaleAnimationDuration);
+    this->InvalidateFrameRateRequirement();
   };
   switch (static_cast<SliderState>(raw)) {
     case SliderState::Normal:
@@ -89,6 +89,10 @@ class Slider final : public Widget, public IFocusable {
   FrameRateRequirement GetFrameRateRequirement() const noexcept override;
 
   void PaintOwnContent(Renderer*, const Rect&, const Style&) const override;
+  [[nodiscard]]
+  bool HasVolatilePaint() const noexcept override {
+    return true;
+  }
 
  private:
   struct Layout {
@@ -20,6 +20,10 @@ class SwapChainPanel final : public Widget {
 
  protected:
   void PaintOwnContent(Renderer*, const Rect&, const Style&) const override;
+  [[nodiscard]]
+  bool HasVolatilePaint() const noexcept override {
+    return true;
+  }
 
  private:
   friend class ::FredEmmott::GUI::SwapChain;
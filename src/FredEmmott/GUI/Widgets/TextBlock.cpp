@@ -72,6 +72,7 @@ void TextBlock::SetText(const std::string_view text) {
     return;
   }
   mText = std::string {text};
+  this->InvalidatePaint();
 
   if (!mFont) {
     return;
@@ -125,13 +126,6 @@ Widget::ComputedStyleFlags TextBlock::OnComputedStyleChange(
     mFont = style.Font().value();
   }
 
-#ifdef FUI_ENABLE_SKIA
-  if (mSkiaParagraph && mSkiaColor != style.Color().value()) {
-    dirtyFlags |= DirtyFlags::Skia_Color;
-    mSkiaColor = style.Color().value();
-  }
-#endif
-
   this->UpdateTextLayout(dirtyFlags);
 
   return ret;
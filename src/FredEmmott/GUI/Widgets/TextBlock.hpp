@@ -10,6 +10,7 @@
 
 #include <FredEmmott/GUI/Style.hpp>
 #include <FredEmmott/utility/bitflag_enums.hpp>
+#include <limits>
 
 #include "Widget.hpp"
 
@@ -33,8 +34,6 @@ class TextBlock final : public Widget {
     None = 0,
     Text = 1 << 0,
     Font = 1 << 1,
-    // https://issues.skia.org/issues/389111535
-    Skia_Color = 1 << 2,
   };
   friend consteval bool is_bitflag_enum(std::type_identity<DirtyFlags>);
 #ifdef FUI_ENABLE_SKIA
@@ -49,8 +48,10 @@ class TextBlock final : public Widget {
 
   void UpdateTextLayout(DirtyFlags);
 #ifdef FUI_ENABLE_SKIA
-  std::optional<Style::PropertyTypes::Color_t> mSkiaColor;
+  // The width passed to the last `Paragraph::layout()`
+  mutable float mSkiaLayoutWidth {std::numeric_limits<float>::quiet_NaN()};
   void UpdateSkiaParagraph();
+  void LayoutSkiaParagraph(float width) const;
   YGSize MeasureWithSkia(
     float width,
     YGMeasureMode widthMode,
@@ -6,6 +6,7 @@
 
 #include <print>
 
+#include "FredEmmott/GUI/FrameProfiler.hpp"
 #include "FredEmmott/GUI/detail/direct_write_detail/DirectWriteFontProvider.hpp"
 #include "FredEmmott/GUI/detail/win32_detail.hpp"
 #include "TextBlock.hpp"
@@ -52,7 +53,9 @@ void TextBlock::UpdateDirectWriteTextLayout() {
     std::numeric_limits<FLOAT>::infinity(),
     std::numeric_limits<FLOAT>::infinity(),
     mDirectWriteTextLayout.put()));
+  FrameProfiler::Count(WidgetCounter::ParagraphsRebuilt, this);
   YGNodeMarkDirty(this->GetLayoutNode());
+  FrameProfiler::Count(WidgetCounter::YogaNodesDirtied, this);
 }
 
 void TextBlock::PaintOwnContent(
@@ -66,6 +69,7 @@ void TextBlock::PaintOwnContent(
     mDirectWriteTextLayout.get(),
     style.Color().value().as<ID2D1Brush*>(renderer, rect),
     D2D1_DRAW_TEXT_OPTIONS_ENABLE_COLOR_FONT);
+  FrameProfiler::CountDrawCall();
 }
 
 }// namespace FredEmmott::GUI::Widgets
\ No newline at end of file
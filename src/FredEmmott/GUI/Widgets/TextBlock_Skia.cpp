@@ -3,12 +3,16 @@
 
 #include <Windows.h>
 #include <Yoga.h>
+#include <skia/core/SkBlurTypes.h>
 #include <skia/core/SkFont.h>
 #include <skia/core/SkFontMgr.h>
+#include <skia/core/SkMaskFilter.h>
 #include <skia/modules/skparagraph/include/ParagraphBuilder.h>
+#include <skia/modules/skparagraph/include/ParagraphPainter.h>
 #include <skia/modules/skunicode/include/SkUnicode_icu.h>
 #include <skia/ports/SkFontMgr_empty.h>
 
+#include <FredEmmott/GUI/FrameProfiler.hpp>
 #include <FredEmmott/GUI/SkiaRenderer.hpp>
 #include <FredEmmott/GUI/StaticTheme.hpp>
 #include <FredEmmott/GUI/assert.hpp>
@@ -20,6 +24,105 @@ using namespace FredEmmott::utility;
 
 namespace FredEmmott::GUI::Widgets {
 
+namespace {
+using skia::textlayout::ParagraphPainter;
+
+// Resolved when painting, so changing the color does not require rebuilding
+// the paragraph
+constexpr ParagraphPainter::PaintID ForegroundPaintID = 0;
+
+/** Paint a paragraph to an `SkCanvas`, with the current foreground paint.
+ *
+ * Skia caches text blobs with their paints on the first paint, so
+ * `Paragraph::updateForegroundPaint()` has no effect after that:
+ * https://issues.skia.org/issues/389111535
+ *
+ * Paint IDs are cached instead of paints, so we substitute the paint here.
+ */
+class SkiaParagraphPainter final : public ParagraphPainter {
+ public:
+  SkiaParagraphPainter(SkCanvas* const canvas, const SkPaint& foreground)
+    : mCanvas(canvas),
+      mForeground(foreground) {}
+
+  void drawTextBlob(
+    const sk_sp<SkTextBlob>& blob,
+    const SkScalar x,
+    const SkScalar y,
+    const SkPaintOrID& paint) override {
+    mCanvas->drawTextBlob(blob, x, y, this->GetPaint(paint));
+  }
+
+  void drawTextShadow(
+    const sk_sp<SkTextBlob>& blob,
+    const SkScalar x,
+    const SkScalar y,
+    const SkColor color,
+    const SkScalar blurSigma) override {
+    SkPaint paint;
+    paint.setColor(color);
+    if (blurSigma != 0) {
+      paint.setMaskFilter(
+        SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, blurSigma, false));
+    }
+    mCanvas->drawTextBlob(blob, x, y, paint);
+  }
+
+  void drawRect(const SkRect& rect, const SkPaintOrID& paint) override {
+    mCanvas->drawRect(rect, this->GetPaint(paint));
+  }
+
+  void drawFilledRect(const SkRect& rect, const DecorationStyle& style)
+    override {
+    auto paint = style.skPaint();
+    paint.setStroke(false);
+    mCanvas->drawRect(rect, paint);
+  }
+
+  void drawPath(const SkPath& path, const DecorationStyle& style) override {
+    mCanvas->drawPath(path, style.skPaint());
+  }
+
+  void drawLine(
+    const SkScalar x0,
+    const SkScalar y0,
+    const SkScalar x1,
+    const SkScalar y1,
+    const DecorationStyle& style) override {
+    mCanvas->drawLine(x0, y0, x1, y1, style.skPaint());
+  }
+
+  void clipRect(const SkRect& rect) override {
+    mCanvas->clipRect(rect);
+  }
+
+  void translate(const SkScalar dx, const SkScalar dy) override {
+    mCanvas->translate(dx, dy);
+  }
+
+  void save() override {
+    mCanvas->save();
+  }
+
+  void restore() override {
+    mCanvas->restore();
+  }
+
+ private:
+  SkCanvas* mCanvas {};
+  const SkPaint& mForeground;
+
+  [[nodiscard]]
+  const SkPaint& GetPaint(const SkPaintOrID& paint) const {
+    if (const auto id = std::get_if<PaintID>(&paint)) {
+      FUI_ASSERT(*id == ForegroundPaintID);
+      return mForeground;
+    }
+    return std::get<SkPaint>(paint);
+  }
+};
+}// namespace
+
 YGSize TextBlock::MeasureWithSkia(
   float width,
   [[maybe_unused]] YGMeasureMode widthMode,
@@ -29,7 +132,7 @@ YGSize TextBlock::MeasureWithSkia(
     width = std::numeric_limits<float>::infinity();
   }
 
-  mSkiaParagraph->layout(width);
+  this->LayoutSkiaParagraph(width);
   mMeasuredHeight = mSkiaParagraph->getHeight();
 
   if (std::isinf(width)) {
@@ -59,14 +162,26 @@ void TextBlock::UpdateSkiaParagraph() {
   TextStyle textStyle;
   textStyle.setFontFamilies({familyName});
   textStyle.setFontSize(font.getSize());
+  textStyle.setForegroundPaintID(ForegroundPaintID);
   ParagraphStyle paragraphStyle;
   paragraphStyle.setTextStyle(textStyle);
   auto builder = skia::textlayout::ParagraphBuilder::make(
     paragraphStyle, FontCollection, SkiaICU);
   builder->addText(mText.data(), mText.size());
   mSkiaParagraph = builder->Build();
+  mSkiaLayoutWidth = std::numeric_limits<float>::quiet_NaN();
+  FrameProfiler::Count(WidgetCounter::ParagraphsRebuilt, this);
 
   YGNodeMarkDirty(this->GetLayoutNode());
+  FrameProfiler::Count(WidgetCounter::YogaNodesDirtied, this);
+}
+
+void TextBlock::LayoutSkiaParagraph(const float width) const {
+  if (width == mSkiaLayoutWidth) {
+    return;
+  }
+  mSkiaParagraph->layout(width);
+  mSkiaLayoutWidth = width;
 }
 
 void TextBlock::PaintOwnContent(
@@ -76,9 +191,10 @@ void TextBlock::PaintOwnContent(
   const Style& style) const {
   auto paint = style.Color().value().as<SkPaint>(renderer, rect);
   paint.setStyle(SkPaint::Style::kFill_Style);
-  mSkiaParagraph->updateForegroundPaint(0, mText.size(), paint);
-  mSkiaParagraph->layout(rect.GetWidth());
-  mSkiaParagraph->paint(canvas, rect.GetLeft(), rect.GetTop());
+  this->LayoutSkiaParagraph(rect.GetWidth());
+  SkiaParagraphPainter painter {canvas, paint};
+  mSkiaParagraph->paint(&painter, rect.GetLeft(), rect.GetTop());
+  FrameProfiler::CountDrawCall();
 }
 
 }// namespace FredEmmott::GUI::Widgets
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include "FredEmmott/GUI/detail/win32_detail/TSFTextStore.hpp"
 #include "FredEmmott/GUI/events/KeyEvent.hpp"
 #include "FredEmmott/GUI/events/MouseEvent.hpp"
+#include "ScrollView.hpp"
 
 using namespace FredEmmott::utility;
 using namespace FredEmmott::GUI::StaticTheme;
@@ -87,29 +88,133 @@ TextBox::~TextBox() = default;
 void TextBox::SetText(const std::string_view text) {
   AssertOwnerThread();
 
-  auto& s = mActiveState;
-  if (text == s.mText) {
+  const std::string_view current = mActiveState.mText;
+  if (text == current) {
     return;
   }
 
+  // Only replace what changed, so that the caches can be updated in place
+  const auto prefix = static_cast<std::size_t>(
+    std::ranges::mismatch(current, text).in1 - current.begin());
+  const auto maxSuffix = std::min(current.size(), text.size()) - prefix;
+  std::size_t suffix = 0;
+  while (suffix < maxSuffix
+         && current[current.size() - suffix - 1]
+           == text[text.size() - suffix - 1]) {
+    ++suffix;
+  }
+
+  this->ReplaceText(
+    prefix,
+    current.size() - suffix,
+    text.substr(prefix, text.size() - suffix - prefix),
+    EditOperation::None);
+}
+
+void TextBox::SetMultiLine(const bool value) {
+  if (value == mIsMultiLine) {
+    return;
+  }
+  mIsMultiLine = value;
+  mCaches.mTextMetrics.reset();
+  mCaches.mLineLayout.reset();
+  mContentScrollX = 0;
+  YGNodeMarkDirty(mTextContainer->GetLayoutNode());
+  FrameProfiler::Count(WidgetCounter::YogaNodesDirtied, mTextContainer);
+}
+
+void TextBox::ReplaceText(
+  const std::size_t begin,
+  const std::size_t end,
+  const std::string_view replacement,
+  const EditOperation op) {
+  AssertOwnerThread();
+
+  const auto& s = mActiveState;
+  FUI_ASSERT(begin <= end && end <= s.mText.size());
+  const auto removed = std::string_view {s.mText}.substr(begin, end - begin);
+  if (removed == replacement) {
+    return;
+  }
+
+  UndoableEdit edit {
+    .mOperation = op,
+    .mOffset = begin,
+    .mRemoved = std::string {removed},
+    .mInserted = std::string {replacement},
+    .mSelectionStart = s.mSelectionStart,
+    .mSelectionEnd = s.mSelectionEnd,
+  };
+  mRedoStack.clear();
+  if (mUndoStack.empty() || !mUndoStack.back().Merge(edit)) {
+    mUndoStack.push_back(std::move(edit));
+    if (mUndoStack.size() > MaxUndoSteps) {
+      mUndoStack.pop_front();
+    }
+  }
+
+  this->SpliceText(begin, end, replacement);
+}
+
+void TextBox::SpliceText(
+  const std::size_t begin,
+  const std::size_t end,
+  const std::string_view replacement) {
+  using namespace win32_detail;
+
+  auto& s = mActiveState;
   mWasChanged = true;
-  const auto oldLength = s.mText.size();
 
-  s.mText = std::string {text};
-  mCaches = {};
+  const auto textChangeSink
+    = mAutomationFlag ? nullptr : mAutomation->GetSink(TS_AS_TEXT_CHANGE);
+  auto& wideText = mCaches.mWideText;
+  // TSF uses UTF-16 offsets
+  std::size_t wideBegin {};
+  std::size_t wideOldEnd {};
+  std::size_t wideNewEnd {};
+  if (textChangeSink || !wideText.empty()) {
+    wideBegin = this->ToWideIndex(begin);
+    wideOldEnd = (begin == end) ? wideBegin : this->ToWideIndex(end);
+  }
+
+  s.mText.replace(begin, end - begin, replacement);
+  const auto newEnd = begin + replacement.size();
+  if (auto& index = mCaches.mUtf16Index) {
+    index->Update(s.mText, begin, end, newEnd);
+  }
+
+  if (textChangeSink || !wideText.empty()) {
+    const auto wideReplacement = Utf8ToWide(replacement);
+    wideNewEnd = wideBegin + wideReplacement.size();
+    // If the cache is empty, it hasn't been populated yet
+    if (!wideText.empty()) {
+      wideText.replace(wideBegin, wideOldEnd - wideBegin, wideReplacement);
+    }
+  }
+
+  this->RetargetIterators();
+  if (mCaches.mTextMetrics) {
+    this->UpdateMetrics(begin, end, newEnd);
+  }
+  if (const auto& layout = mCaches.mLineLayout) {
+    layout->Update(s.mText, begin, end, newEnd);
+  }
+  mContentScrollX = std::min(mContentScrollX, begin);
   this->SetSelection(s.mSelectionStart, s.mSelectionEnd);
   YGNodeMarkDirty(mTextContainer->GetLayoutNode());
+  FrameProfiler::Count(WidgetCounter::YogaNodesDirtied, mTextContainer);
 
   if (mAutomationFlag) {
     return;
   }
 
-  if (const auto sink = mAutomation->GetSink(TS_AS_TEXT_CHANGE)) {
+  if (textChangeSink) {
     const TS_TEXTCHANGE textChange {
-      .acpOldEnd = static_cast<LONG>(oldLength),
-      .acpNewEnd = static_cast<LONG>(s.mText.size()),
+      .acpStart = static_cast<LONG>(wideBegin),
+      .acpOldEnd = static_cast<LONG>(wideOldEnd),
+      .acpNewEnd = static_cast<LONG>(wideNewEnd),
     };
-    CheckHResult(sink->OnTextChange(0, &textChange));
+    CheckHResult(textChangeSink->OnTextChange(0, &textChange));
   }
   if (const auto sink = mAutomation->GetSink(TS_AS_LAYOUT_CHANGE)) {
     CheckHResult(sink->OnLayoutChange(TS_LC_CHANGE, 1));
@@ -119,6 +224,97 @@ void TextBox::SetText(const std::string_view text) {
   }
 }
 
+void TextBox::RetargetIterators() const {
+  auto& c = mCaches;
+  if (!c.mUText) {
+    // The break iterators are created from the UText, so there are none
+    return;
+  }
+
+  // Re-opening an existing UText or re-targeting a break iterator is cheap;
+  // `ubrk_open()` needs to load the break rules
+  const auto& text = mActiveState.mText;
+  UErrorCode status = U_ZERO_ERROR;
+  utext_openUTF8(c.mUText.get(), text.data(), text.size(), &status);
+  for (auto&& it: {c.mGraphemeIterator.get(), c.mWordIterator.get()}) {
+    if (it) {
+      ubrk_setUText(it, c.mUText.get(), &status);
+    }
+  }
+}
+
+bool TextBox::UndoableEdit::Merge(const UndoableEdit& next) {
+  if (next.mOperation != mOperation) {
+    return false;
+  }
+
+  using enum EditOperation;
+  switch (mOperation) {
+    case Typing:
+      // Typing over a selection is a new step
+      if (!next.mRemoved.empty()) {
+        return false;
+      }
+      if (next.mOffset != mOffset + mInserted.size()) {
+        return false;
+      }
+      mInserted += next.mInserted;
+      return true;
+    case DeleteLeft:
+      if (!next.mInserted.empty()) {
+        return false;
+      }
+      if (next.mOffset + next.mRemoved.size() != mOffset) {
+        return false;
+      }
+      mRemoved.insert(0, next.mRemoved);
+      mOffset = next.mOffset;
+      return true;
+    case DeleteRight:
+      if (!next.mInserted.empty()) {
+        return false;
+      }
+      if (next.mOffset != mOffset) {
+        return false;
+      }
+      mRemoved += next.mRemoved;
+      return true;
+    case None:
+    case Cut:
+    case Paste:
+      return false;
+  }
+  std::unreachable();
+}
+
+void TextBox::Undo() {
+  AssertOwnerThread();
+  if (mUndoStack.empty()) {
+    return;
+  }
+
+  auto edit = std::move(mUndoStack.back());
+  mUndoStack.pop_back();
+  this->SpliceText(
+    edit.mOffset, edit.mOffset + edit.mInserted.size(), edit.mRemoved);
+  this->SetSelection(edit.mSelectionStart, edit.mSelectionEnd);
+  mRedoStack.push_back(std::move(edit));
+}
+
+void TextBox::Redo() {
+  AssertOwnerThread();
+  if (mRedoStack.empty()) {
+    return;
+  }
+
+  auto edit = std::move(mRedoStack.back());
+  mRedoStack.pop_back();
+  this->SpliceText(
+    edit.mOffset, edit.mOffset + edit.mRemoved.size(), edit.mInserted);
+  this->SetCaret(edit.mOffset + edit.mInserted.size());
+  mUndoStack.push_back(std::move(edit));
+}
+
 FrameRateRequirement TextBox::GetFrameRateRequirement() const noexcept {
   // If caret should blink, request caret-level frame rate
   if (!mIsFocused) {
@@ -151,10 +347,43 @@ std::wstring_view TextBox::GetTextW() const noexcept {
   return wideText;
 }
 
+detail::Utf16Index& TextBox::GetUtf16Index() const {
+  auto& index = mCaches.mUtf16Index;
+  if (!index) {
+    index.emplace(mActiveState.mText);
+  }
+  return *index;
+}
+
+std::size_t TextBox::ToWideIndex(const std::size_t utf8Index) const {
+  if (utf8Index == 0) {
+    return 0;
+  }
+  return this->GetUtf16Index().ToUtf16(mActiveState.mText, utf8Index);
+}
+
+std::size_t TextBox::ToUtf8Index(const std::size_t wideIndex) const {
+  if (wideIndex == 0) {
+    return 0;
+  }
+  return this->GetUtf16Index().ToUtf8(mActiveState.mText, wideIndex);
+}
+
 void TextBox::SetTextW(const std::wstring_view wide) {
   SetText(win32_detail::WideToUtf8(wide));
 }
 
+void TextBox::ReplaceTextW(
+  const std::size_t begin,
+  const std::size_t end,
+  const std::wstring_view replacement) {
+  using namespace win32_detail;
+  const auto utf8Begin = this->ToUtf8Index(begin);
+  const auto utf8End = (begin == end) ? utf8Begin : this->ToUtf8Index(end);
+  this->ReplaceText(
+    utf8Begin, utf8End, WideToUtf8(replacement), EditOperation::Typing);
+}
+
 Rect TextBox::GetContentRect() const noexcept {
   const auto yoga = this->GetLayoutNode();
   // Full area of the text box
@@ -175,19 +404,15 @@ Rect TextBox::GetContentRect() const noexcept {
 }
 
 std::pair<std::size_t, std::size_t> TextBox::GetSelectionW() const {
-  using namespace win32_detail;
   const auto [begin, end] = GetSelection();
-  const auto wideBegin = Utf8ToWideIndex(mActiveState.mText, begin);
-  const auto wideEnd
-    = (begin == end) ? wideBegin : Utf8ToWideIndex(mActiveState.mText, end);
+  const auto wideBegin = this->ToWideIndex(begin);
+  const auto wideEnd = (begin == end) ? wideBegin : this->ToWideIndex(end);
   return {wideBegin, wideEnd};
 }
 
 void TextBox::SetSelectionW(const std::size_t begin, const std::size_t end) {
-  using namespace win32_detail;
-  const auto text = GetTextW();
-  const auto utf8Begin = WideToUtf8Index(text, begin);
-  const auto utf8End = (begin == end) ? utf8Begin : WideToUtf8Index(text, end);
+  const auto utf8Begin = this->ToUtf8Index(begin);
+  const auto utf8End = (begin == end) ? utf8Begin : this->ToUtf8Index(end);
   this->SetSelection(utf8Begin, utf8End);
 }
 
@@ -198,10 +423,8 @@ void TextBox::SelectAll() {
 TextBox::BoundingBox TextBox::GetTextBoundingBoxW(
   const std::size_t begin,
   const std::size_t end) const noexcept {
-  using namespace win32_detail;
-  const auto text = GetTextW();
-  const auto utf8Begin = WideToUtf8Index(text, begin);
-  const auto utf8End = (begin == end) ? utf8Begin : WideToUtf8Index(text, end);
+  const auto utf8Begin = this->ToUtf8Index(begin);
+  const auto utf8End = (begin == end) ? utf8Begin : this->ToUtf8Index(end);
   return GetTextBoundingBox(utf8Begin, utf8End);
 }
 
@@ -212,6 +435,9 @@ void TextBox::Tick(const std::chrono::steady_clock::time_point& now) {
   const auto isFocused = window->GetFocusManager()->IsWidgetFocused(this);
   const bool focusChanged = (isFocused != mIsFocused);
   mIsFocused = isFocused;
+  if (focusChanged) {
+    this->InvalidateFrameRateRequirement();
+  }
 
   // Manage TSF document activation on focus changes
   if (focusChanged) {
@@ -255,7 +481,7 @@ void TextBox::Tick(const std::chrono::steady_clock::time_point& now) {
 }
 
 Widget::EventHandlerResult TextBox::OnTextInput(const TextInputEvent& e) {
-  this->ReplaceSelection(e.mText, UndoableState::Operation::Typing);
+  this->ReplaceSelection(e.mText, EditOperation::Typing);
   return EventHandlerResult::StopPropagation;
 }
 
@@ -263,27 +489,30 @@ void TextBox::DeleteSelection(const DeleteDirection ifSelectionEmpty) {
   AssertOwnerThread();
 
   using enum DeleteDirection;
-  auto& s = mActiveState;
-  if (s.mSelectionStart == s.mSelectionEnd) {
+  const auto& s = mActiveState;
+  auto left = std::min(s.mSelectionStart, s.mSelectionEnd);
+  auto right = std::max(s.mSelectionStart, s.mSelectionEnd);
+  if (left == right) {
     switch (ifSelectionEmpty) {
       case DeleteLeft:
-        if (s.mSelectionEnd > 0) {
-          s.mSelectionEnd
-            = ubrk_preceding(GetGraphemeIterator(), s.mSelectionEnd);
+        if (left > 0) {
+          left = ubrk_preceding(GetGraphemeIterator(), left);
         }
         break;
       case DeleteRight:
-        if (s.mSelectionEnd < s.mText.size()) {
-          s.mSelectionEnd
-            = ubrk_following(GetGraphemeIterator(), s.mSelectionEnd);
+        if (right < s.mText.size()) {
+          right = ubrk_following(GetGraphemeIterator(), right);
         }
         break;
     }
   }
 
-  const auto [left, right] = std::minmax(s.mSelectionStart, s.mSelectionEnd);
-  this->SetText(
-    std::format("{}{}", s.mText.substr(0, left), s.mText.substr(right)));
+  this->ReplaceText(
+    left,
+    right,
+    {},
+    (ifSelectionEmpty == DeleteLeft) ? EditOperation::DeleteLeft
+                                     : EditOperation::DeleteRight);
   this->SetCaret(left);
 }
 
@@ -317,7 +546,7 @@ Widget::EventHandlerResult TextBox::OnKeyPress(const KeyPressEvent& e) {
         const auto [left, right]
           = std::minmax(s.mSelectionStart, s.mSelectionEnd);
         GetOwnerWindow()->SetClipboardText(s.mText.substr(left, right - left));
-        this->ReplaceSelection({}, UndoableState::Operation::Cut);
+        this->ReplaceSelection({}, EditOperation::Cut);
       }
       return StopPropagation;
     case Key_V: {
@@ -326,41 +555,91 @@ Widget::EventHandlerResult TextBox::OnKeyPress(const KeyPressEvent& e) {
       }
 
       if (const auto pasted = GetOwnerWindow()->GetClipboardText()) {
-        this->ReplaceSelection(*pasted, UndoableState::Operation::Paste);
+        this->ReplaceSelection(*pasted, EditOperation::Paste);
       }
 
       return StopPropagation;
     }
     case Key_Z:
       if (e.mModifiers == Modifier_Control) {
-        mCaches = {};
-        std::swap(mActiveState, mUndoState);
-        YGNodeMarkDirty(this->GetLayoutNode());
-        // TODO: notify IME
+        this->Undo();
+      } else if (e.mModifiers == (Modifier_Control | Modifier_Shift)) {
+        this->Redo();
+      }
+      return StopPropagation;
+    case Key_Y:
+      if (e.mModifiers == Modifier_Control) {
+        this->Redo();
       }
       return StopPropagation;
     case Key_Backspace:
-      BeforeOperation(UndoableState::Operation::DeleteLeft);
       this->DeleteSelection(DeleteDirection::DeleteLeft);
       return StopPropagation;
     case Key_Insert:
       if (e.mModifiers == Modifier_Shift) {
         // Shift-Insert is an alternative paste
         if (const auto pasted = GetOwnerWindow()->GetClipboardText()) {
-          this->ReplaceSelection(*pasted, UndoableState::Operation::Paste);
+          this->ReplaceSelection(*pasted, EditOperation::Paste);
         }
       }
       return StopPropagation;
     case Key_Delete:
-      BeforeOperation(UndoableState::Operation::DeleteRight);
       this->DeleteSelection(DeleteDirection::DeleteRight);
       return StopPropagation;
+    case Key_Return:
+      if (mIsMultiLine) {
+        this->ReplaceSelection("\n", EditOperation::Typing);
+      }
+      return StopPropagation;
     case Key_Home:
+      if (mIsMultiLine && (e.mModifiers & Modifier_Control) == Modifier_None) {
+        const auto& layout = this->GetLineLayout();
+        newIdx = layout.GetLine(layout.GetLineIndex(s.mSelectionEnd)).mBegin;
+        break;
+      }
       newIdx = 0;
       break;
     case Key_End:
+      if (mIsMultiLine && (e.mModifiers & Modifier_Control) == Modifier_None) {
+        const auto& layout = this->GetLineLayout();
+        const auto lineIndex = layout.GetLineIndex(s.mSelectionEnd);
+        const auto line = layout.GetLine(lineIndex);
+        newIdx = line.mEnd;
+        if (
+          lineIndex + 1 < layout.GetLineCount()
+          && layout.GetLine(lineIndex + 1).mBegin == line.mEnd) {
+          // Wrapped; the end of this line is the start of the next line
+          newIdx = ubrk_preceding(GetGraphemeIterator(), line.mEnd);
+        }
+        break;
+      }
       newIdx = s.mText.size();
       break;
+    case Key_UpArrow:
+    case Key_DownArrow:
+      if (!mIsMultiLine) {
+        break;
+      }
+      if (
+        (s.mSelectionStart != s.mSelectionEnd)
+        && (e.mModifiers & Modifier_Shift) == Modifier_None) {
+        newIdx = (e.mKeyCode == Key_UpArrow)
+          ? std::min(s.mSelectionStart, s.mSelectionEnd)
+          : std::max(s.mSelectionStart, s.mSelectionEnd);
+        break;
+      }
+      {
+        const auto x = this->GetVerticalNavigationX();
+        const auto idx = this->GetVerticalNavigationIndex(
+          (e.mKeyCode == Key_UpArrow) ? -1 : 1, x);
+        if ((e.mModifiers & Modifier_Shift) == Modifier_Shift) {
+          this->SetSelection(s.mSelectionStart, idx);
+        } else {
+          this->SetCaret(idx);
+        }
+        mVerticalNavigationX = x;
+      }
+      return StopPropagation;
     case Key_LeftArrow:
       if (
         (s.mSelectionStart != s.mSelectionEnd)
@@ -393,7 +672,7 @@ Widget::EventHandlerResult TextBox::OnKeyPress(const KeyPressEvent& e) {
       if (e.mModifiers != Modifier_Control) {
         return Widget::OnKeyPress(e);
       }
-      this->ReplaceSelection("\t", UndoableState::Operation::Typing);
+      this->ReplaceSelection("\t", EditOperation::Typing);
       return StopPropagation;
     default:
       break;
@@ -421,8 +700,7 @@ Widget::EventHandlerResult TextBox::OnMouseButtonPress(const MouseEvent& e) {
   }
 
   // Update caret immediately on press and begin possible drag selection
-  const auto pos = e.GetPosition();
-  const auto idx = this->IndexFromLocalX(pos.mX);
+  const auto idx = this->IndexFromLocalPoint(e.GetPosition());
   mMouseSelectionAnchor = idx;
   this->SetCaret(idx);
 
@@ -440,8 +718,7 @@ Widget::EventHandlerResult TextBox::OnMouseMove(const MouseEvent& e) {
     return Default;
   }
 
-  const auto pos = e.GetPosition();
-  const auto idx = this->IndexFromLocalX(pos.mX);
+  const auto idx = this->IndexFromLocalPoint(e.GetPosition());
   this->SetSelection(*mMouseSelectionAnchor, idx);
   return StopPropagation;
 }
@@ -470,9 +747,19 @@ void TextBox::PaintCursor(
     return;
   }
 
-  const auto& metrics = this->GetMetrics();
   const auto& s = mActiveState;
-  const auto midX = metrics.mOffsetX[s.mSelectionStart];
+  float midX {};
+  float top = rect.GetTop();
+  float height = rect.GetHeight();
+  if (mIsMultiLine) {
+    const auto& layout = this->GetLineLayout();
+    const auto caret = layout.GetCaretPoint(s.mSelectionStart);
+    midX = caret.mX;
+    top += caret.mY;
+    height = layout.GetLineHeight();
+  } else {
+    midX = this->GetMetrics().mOffsetX[s.mSelectionStart];
+  }
 
   const auto width = static_cast<float>(SystemSettings::Get().GetCaretWidth());
   const auto left = midX - (width / 2);
@@ -481,60 +768,276 @@ void TextBox::PaintCursor(
     Rect {
       Point {
         rect.GetLeft() + left,
-        rect.GetTop(),
+        top,
       },
       Size {
         width,
-        rect.GetHeight(),
+        height,
       },
     });
 }
 
+void TextBox::PaintMultiLine(Renderer* renderer, const Style& style) const {
+  const auto& s = mActiveState;
+  const std::string_view text = s.mText;
+  const auto rect = this->GetContentRect();
+  const auto clipTo = renderer->ScopedClipRect(rect);
+
+  const auto& layout = this->GetLineLayout();
+  const auto& font = style.Font().value();
+  const auto& color = style.Color().value();
+
+  const auto left = std::min(s.mSelectionStart, s.mSelectionEnd);
+  const auto right = std::max(s.mSelectionStart, s.mSelectionEnd);
+
+  const auto [firstLine, endLine] = this->GetVisibleLines();
+  for (auto i = firstLine; i < endLine; ++i) {
+    const auto line = layout.GetLine(i);
+    const auto top = rect.GetTop() + line.mTop;
+    const auto baseline = top + layout.GetBaseline();
+
+    const auto selectionBegin = std::clamp(left, line.mBegin, line.mEnd);
+    const auto selectionEnd = std::clamp(right, line.mBegin, line.mEnd);
+    const auto selectionLeft = layout.GetOffsetX(i, selectionBegin);
+    const auto selectionRight = layout.GetOffsetX(i, selectionEnd);
+    if (selectionBegin != selectionEnd) {
+      renderer->FillRect(
+        Colors::Blue,
+        Rect {
+          Point {rect.GetLeft() + selectionLeft, top},
+          Size {selectionRight - selectionLeft, layout.GetLineHeight()},
+        });
+    }
+
+    const auto draw = [&](
+                        const std::size_t begin,
+                        const std::size_t end,
+                        const Brush& brush) {
+      if (begin == end) {
+        return;
+      }
+      renderer->DrawText(
+        brush,
+        rect,
+        font,
+        text.substr(begin, end - begin),
+        Point {rect.GetLeft() + layout.GetOffsetX(i, begin), baseline});
+    };
+    draw(line.mBegin, selectionBegin, color);
+    draw(selectionBegin, selectionEnd, Colors::White);
+    draw(selectionEnd, line.mEnd, color);
+  }
+
+  if (left == right) {
+    this->PaintCursor(renderer, rect, style);
+  }
+}
+
+std::pair<std::size_t, std::size_t> TextBox::GetVisibleLines() const {
+  const auto& layout = this->GetLineLayout();
+  const auto rect = this->GetContentRect();
+
+  // In our content coordinate space
+  float top = 0;
+  float bottom = rect.GetHeight();
+  for (auto it = this->GetStructuralParentOrNull(); it;
+       it = it->GetStructuralParentOrNull()) {
+    const auto scrollView = dynamic_cast<ScrollView*>(it);
+    if (!scrollView) {
+      continue;
+    }
+    const auto offset
+      = this->GetTopLeftCanvasPoint(scrollView).mY + rect.GetTop();
+    top = std::max(top, -offset);
+    bottom = std::min(bottom, scrollView->GetSize().mHeight - offset);
+    break;
+  }
+
+  const auto lineHeight = layout.GetLineHeight();
+  const auto lineCount = layout.GetLineCount();
+  const auto first = std::min(
+    lineCount,
+    static_cast<std::size_t>(std::floor(std::max(top, 0.f) / lineHeight)));
+  const auto end = std::clamp(
+    static_cast<std::size_t>(std::ceil(std::max(bottom, 0.f) / lineHeight)),
+    first,
+    lineCount);
+  return {first, end};
+}
+
+void TextBox::ScrollCaretIntoView() {
+  if (!mIsFocused) {
+    return;
+  }
+  const auto& layout = this->GetLineLayout();
+  const auto caret = layout.GetCaretPoint(mActiveState.mSelectionEnd);
+  const auto rect = this->GetContentRect();
+  this->EnsureVisible(
+    Rect {
+      rect.GetTopLeft() + caret,
+      Size {
+        static_cast<float>(SystemSettings::Get().GetCaretWidth()),
+        layout.GetLineHeight(),
+      },
+    });
+}
+
+float TextBox::GetVerticalNavigationX() const {
+  if (mVerticalNavigationX) {
+    return *mVerticalNavigationX;
+  }
+  return this->GetLineLayout().GetCaretPoint(mActiveState.mSelectionEnd).mX;
+}
+
+std::size_t TextBox::GetVerticalNavigationIndex(
+  const std::ptrdiff_t lines,
+  const float x) const {
+  const auto& layout = this->GetLineLayout();
+  const auto target
+    = static_cast<std::ptrdiff_t>(
+        layout.GetLineIndex(mActiveState.mSelectionEnd))
+    + lines;
+  if (target < 0) {
+    return 0;
+  }
+  if (target >= static_cast<std::ptrdiff_t>(layout.GetLineCount())) {
+    return mActiveState.mText.size();
+  }
+  return layout.GetIndexAtPoint({
+    x,
+    (static_cast<float>(target) + 0.5f) * layout.GetLineHeight(),
+  });
+}
+
+detail::TextLineLayout& TextBox::GetLineLayout() const {
+  FUI_ASSERT(mIsMultiLine);
+  const auto& font = this->GetComputedStyle().Font().value();
+  auto& layout = mCaches.mLineLayout;
+  if (layout && layout->GetFont() == font) {
+    return *layout;
+  }
+
+  const auto wrapWidth = layout ? layout->GetWrapWidth() : 0.0f;
+  layout = std::make_unique<detail::TextLineLayout>(
+    font, mActiveState.mText, wrapWidth);
+  return *layout;
+}
+
 const TextBox::TextMetrics& TextBox::GetMetrics() const {
-  if (mCaches.mTextMetrics) {
+  FUI_ASSERT(!mIsMultiLine);
+  const auto& font = this->GetComputedStyle().Font().value();
+  if (mCaches.mTextMetrics && mCaches.mTextMetrics->mFont == font) {
     return mCaches.mTextMetrics.value();
   }
 
-  const auto& font = this->GetComputedStyle().Font().value();
   const auto& fontMetrics = font.GetMetrics();
+  const auto& text = mActiveState.mText;
   TextMetrics ret {
-    .mOffsetX = {0.0f},
+    .mOffsetX = font.MeasureTextOffsets(text),
     .mAscent = fontMetrics.mAscent,
     .mDescent = fontMetrics.mDescent,
+    .mFont = font,
   };
+  this->MaskNonGraphemeBoundaries(&ret.mOffsetX, 0, text.size());
 
-  const auto& text = mActiveState.mText;
-  ret.mOffsetX.reserve(text.size() + 1);
+  mCaches.mTextMetrics.emplace(std::move(ret));
+  return mCaches.mTextMetrics.value();
+}
+
+void TextBox::UpdateMetrics(
+  const std::size_t begin,
+  const std::size_t oldEnd,
+  const std::size_t newEnd) const {
+  const std::string_view newText = mActiveState.mText;
+  const auto& font = this->GetComputedStyle().Font().value();
+  auto& metrics = mCaches.mTextMetrics.value();
+  if (metrics.mFont != font) {
+    // `GetMetrics()` will start over
+    mCaches.mTextMetrics.reset();
+    return;
+  }
+
+  const auto newSize = newText.size();
+  const auto oldSize = (newSize - newEnd) + oldEnd;
 
+  // Measure from one grapheme before the edit to one after, so that shaping
+  // and kerning against the neighboring text are included
   const auto it = GetGraphemeIterator();
-  ubrk_first(it);
-  for (int32_t next = ubrk_next(it); next != UBRK_DONE; next = ubrk_next(it)) {
-    const auto width
-      = font.MeasureTextWidth(text.substr(0, static_cast<std::size_t>(next)));
-    if (next > 0) {
-      ret.mOffsetX.resize(next, std::numeric_limits<float>::signaling_NaN());
-    }
-    ret.mOffsetX.emplace_back(width);
+  const auto first = (begin > 0)
+    ? static_cast<std::size_t>(
+        std::max(ubrk_preceding(it, static_cast<int32_t>(begin)), 0))
+    : 0;
+  const auto following = (newEnd < newSize)
+    ? ubrk_following(it, static_cast<int32_t>(newEnd))
+    : UBRK_DONE;
+  const auto last
+    = (following == UBRK_DONE) ? newSize : static_cast<std::size_t>(following);
+  const auto oldLast = oldSize - (newSize - last);
+
+  auto& offsets = metrics.mOffsetX;
+  FUI_ASSERT(offsets.size() == oldSize + 1);
+  if (std::isnan(offsets.at(first)) || std::isnan(offsets.at(oldLast))) {
+    // The edit moved grapheme boundaries outside of the edited range, e.g.
+    // by adding a combining character; `GetMetrics()` will start over
+    mCaches.mTextMetrics.reset();
+    return;
   }
 
-  mCaches.mTextMetrics.emplace(std::move(ret));
-  return mCaches.mTextMetrics.value();
+  const auto segment
+    = font.MeasureTextOffsets(newText.substr(first, last - first));
+  const auto originX = offsets[first];
+  const auto delta = (originX + segment.back()) - offsets[oldLast];
+
+  // Only grow or shrink the edited range; the tail is moved at most once
+  const auto oldCount = (oldLast - first) + 1;
+  if (segment.size() > oldCount) {
+    offsets.insert(
+      offsets.begin() + oldLast + 1, segment.size() - oldCount, 0.0f);
+  } else if (segment.size() < oldCount) {
+    offsets.erase(
+      offsets.begin() + first + segment.size(),
+      offsets.begin() + oldLast + 1);
+  }
+  FUI_ASSERT(offsets.size() == newSize + 1);
+  std::ranges::transform(
+    segment, offsets.begin() + first, [originX](const float x) {
+      return originX + x;
+    });
+  // NaN for non-boundaries is preserved
+  if (delta != 0) {
+    for (auto i = last + 1; i <= newSize; ++i) {
+      offsets[i] += delta;
+    }
+  }
+  this->MaskNonGraphemeBoundaries(&offsets, first, last);
 }
 
-void TextBox::BeforeOperation(const UndoableState::Operation op) {
-  if (op == mActiveState.mOperation) {
-    return;
+void TextBox::MaskNonGraphemeBoundaries(
+  std::vector<float>* offsets,
+  const std::size_t begin,
+  const std::size_t end) const {
+  const auto it = GetGraphemeIterator();
+  auto previous = begin;
+  for (auto next = ubrk_following(it, static_cast<int32_t>(begin));
+       next != UBRK_DONE && static_cast<std::size_t>(next) <= end;
+       next = ubrk_next(it)) {
+    std::fill(
+      offsets->begin() + previous + 1,
+      offsets->begin() + next,
+      std::numeric_limits<float>::signaling_NaN());
+    previous = static_cast<std::size_t>(next);
   }
-  mUndoState = mActiveState;
-  mUndoState.mOperation = UndoableState::Operation::None;
-  mActiveState.mOperation = op;
-  mCaches = {};
 }
 
 void TextBox::PaintOwnContent(
   Renderer* renderer,
   const Rect&,
   const Style& style) const {
+  if (mIsMultiLine) {
+    this->PaintMultiLine(renderer, style);
+    return;
+  }
+
   const auto& s = mActiveState;
   const auto rect = this->GetContentRect();
 
@@ -586,13 +1089,31 @@ void TextBox::SetSelection(const std::size_t start, const std::size_t end) {
   // Reset caret blink on movement/selection change
   mCaretVisible = true;
   mLastCaretToggleAt = std::chrono::steady_clock::now();
+  this->InvalidateFrameRateRequirement();
 
-  if (start == 0 || end == 0) {
+  mVerticalNavigationX.reset();
+
+  if (mIsMultiLine) {
+    this->ScrollCaretIntoView();
+  } else if (start == 0 || end == 0) {
     mContentScrollX = 0;
     return;
+  } else {
+    this->UpdateContentScrollX();
   }
 
-  // Adjust scroll to keep caret visible
+  if (mAutomationFlag) {
+    return;
+  }
+
+  if (const auto sink = mAutomation->GetSink(TS_AS_SEL_CHANGE))
+    CheckHResult(sink->OnSelectionChange());
+  if (const auto sink = mAutomation->GetSink(TS_AS_LAYOUT_CHANGE))
+    CheckHResult(sink->OnLayoutChange(TS_LC_CHANGE, 1));
+}
+
+void TextBox::UpdateContentScrollX() {
+  const auto& s = mActiveState;
   const auto rect = this->GetContentRect();
   const auto& metrics = this->GetMetrics();
   const auto caretPos = s.mSelectionEnd;
@@ -614,26 +1135,15 @@ void TextBox::SetSelection(const std::size_t start, const std::size_t end) {
       }
     }
   }
-
-  if (mAutomationFlag) {
-    return;
-  }
-
-  if (const auto sink = mAutomation->GetSink(TS_AS_SEL_CHANGE))
-    CheckHResult(sink->OnSelectionChange());
-  if (const auto sink = mAutomation->GetSink(TS_AS_LAYOUT_CHANGE))
-    CheckHResult(sink->OnLayoutChange(TS_LC_CHANGE, 1));
 }
 
 void TextBox::ReplaceSelection(
   const std::string_view newContent,
-  const UndoableState::Operation op) {
-  this->BeforeOperation(op);
+  const EditOperation op) {
   const auto& s = mActiveState;
-  const auto [left, right] = std::minmax(s.mSelectionStart, s.mSelectionEnd);
-  this->SetText(
-    std::format(
-      "{}{}{}", s.mText.substr(0, left), newContent, s.mText.substr(right)));
+  const auto left = std::min(s.mSelectionStart, s.mSelectionEnd);
+  const auto right = std::max(s.mSelectionStart, s.mSelectionEnd);
+  this->ReplaceText(left, right, newContent, op);
   this->SetCaret(left + newContent.size());
 }
 
@@ -700,13 +1210,21 @@ std::size_t TextBox::GetNextWordBoundary() const noexcept {
   return mActiveState.mText.size();
 }
 
-std::size_t TextBox::IndexFromLocalX(const float x) const noexcept {
+std::size_t TextBox::IndexFromLocalPoint(const Point& point) const noexcept {
+  if (mIsMultiLine) {
+    const auto rect = this->GetContentRect();
+    return this->GetLineLayout().GetIndexAtPoint({
+      point.mX - rect.GetLeft(),
+      point.mY - rect.GetTop(),
+    });
+  }
+
   // Convert from local widget X to content X (inside padding/border)
   const auto yoga = this->GetLayoutNode();
   const float leftInset = YGNodeLayoutGetPadding(yoga, YGEdgeLeft)
     + YGNodeLayoutGetBorder(yoga, YGEdgeLeft);
 
-  const float contentX = x - leftInset;
+  const float contentX = point.mX - leftInset;
 
   const auto& offsets = this->GetMetrics().mOffsetX;
 
@@ -738,6 +1256,28 @@ TextBox::BoundingBox TextBox::GetTextBoundingBox(
   const std::size_t begin,
   const std::size_t end) const noexcept {
   const auto contentRect = this->GetContentRect();
+  if (mIsMultiLine) {
+    const auto& layout = this->GetLineLayout();
+    const auto firstLine = layout.GetLineIndex(begin);
+    const auto lastLine = layout.GetLineIndex(end);
+    const auto top = layout.GetLine(firstLine).mTop;
+    const auto bottom = layout.GetLine(lastLine).mTop + layout.GetLineHeight();
+    // If the range spans multiple lines, use the full width
+    auto left = 0.f;
+    auto right = contentRect.GetWidth();
+    if (firstLine == lastLine) {
+      left = layout.GetOffsetX(firstLine, begin);
+      right = layout.GetOffsetX(firstLine, end);
+    }
+    return BoundingBox {
+      Rect {
+        contentRect.GetTopLeft() + Point {left, top},
+        Size {right - left, bottom - top},
+      },
+      bottom > contentRect.GetHeight(),
+    };
+  }
+
   const auto& metrics = this->GetMetrics();
 
   const auto scrollOffset = metrics.mOffsetX[mContentScrollX];
@@ -762,14 +1302,30 @@ TextBox::BoundingBox TextBox::GetTextBoundingBox(
 
 YGSize TextBox::Measure(
   const YGNode* node,
-  [[maybe_unused]] float width,
-  [[maybe_unused]] YGMeasureMode widthMode,
+  const float width,
+  const YGMeasureMode widthMode,
   [[maybe_unused]] float height,
   [[maybe_unused]] YGMeasureMode heightMode) {
   // Getting the parent as `node` is the 'text' child node
   const auto& self = *static_cast<TextBox*>(
     FromYogaNode(YGNodeGetParent(const_cast<YGNode*>(node))));
 
+  if (self.mIsMultiLine) {
+    auto& layout = self.GetLineLayout();
+    if (widthMode == YGMeasureModeUndefined) {
+      // Wrapping again for every speculative measurement would be expensive,
+      // so this is an estimate; we'll be measured again with a real width
+      return {layout.GetNaturalWidth(), layout.GetHeight()};
+    }
+    layout.SetWrapWidth(width);
+    const auto naturalWidth = layout.GetNaturalWidth();
+    return {
+      (widthMode == YGMeasureModeExactly) ? width
+                                          : std::min(width, naturalWidth),
+      layout.GetHeight(),
+    };
+  }
+
   const auto& metrics = self.GetMetrics();
 
   return {
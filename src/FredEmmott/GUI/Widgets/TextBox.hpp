@@ -3,11 +3,14 @@
 #pragma once
 
 #include <chrono>
+#include <deque>
 #include <mutex>
 #include <vector>
 
 #include "Focusable.hpp"
 #include "FredEmmott/GUI/detail/AutomationActivityFlag.hpp"
+#include "FredEmmott/GUI/detail/TextLineLayout.hpp"
+#include "FredEmmott/GUI/detail/Utf16Index.hpp"
 #include "FredEmmott/GUI/detail/icu.hpp"
 #include "Label.hpp"
 #include "Widget.hpp"
@@ -40,6 +43,17 @@ class TextBox : public Widget, public IFocusable {
 
   void SetText(std::string_view);
 
+  /** Accept newlines, and wrap words.
+   *
+   * Multi-line text boxes grow to fit their content, and only paint the lines
+   * that are visible in the nearest `ScrollView` ancestor.
+   */
+  void SetMultiLine(bool);
+  [[nodiscard]]
+  bool IsMultiLine() const noexcept {
+    return mIsMultiLine;
+  }
+
   FrameRateRequirement GetFrameRateRequirement() const noexcept override;
   [[nodiscard]] std::string_view GetText() const noexcept {
     return mActiveState.mText;
@@ -55,11 +69,16 @@ class TextBox : public Widget, public IFocusable {
 
   [[nodiscard]] std::wstring_view GetTextW() const noexcept;
   void SetTextW(std::wstring_view);
+  /// Replace the UTF-16 code units in `[begin, end)`, e.g. for an IME
+  void ReplaceTextW(std::size_t begin, std::size_t end, std::wstring_view);
 
   [[nodiscard]] std::pair<std::size_t, std::size_t> GetSelectionW() const;
   void SetSelectionW(std::size_t begin, std::size_t end);
   void SelectAll();
 
+  void Undo();
+  void Redo();
+
   [[nodiscard]]
   BoundingBox GetTextBoundingBoxW(std::size_t begin, std::size_t end)
     const noexcept;
@@ -69,6 +88,10 @@ class TextBox : public Widget, public IFocusable {
   EventHandlerResult OnTextInput(const TextInputEvent&) override;
   EventHandlerResult OnKeyPress(const KeyPressEvent&) override;
   void PaintOwnContent(Renderer*, const Rect&, const Style&) const override;
+  [[nodiscard]]
+  bool HasVolatilePaint() const noexcept override {
+    return true;
+  }
   [[nodiscard]] EventHandlerResult OnMouseButtonPress(
     const MouseEvent&) override;
   [[nodiscard]] EventHandlerResult OnMouseMove(const MouseEvent&) override;
@@ -92,45 +115,76 @@ class TextBox : public Widget, public IFocusable {
 
   struct TextMetrics {
     // Cumulative width at each byte index into the UTF-8 string.
-    // mWidthToIndex[i] is the width of text.substr(0, i).
-    // Size is text.size() + 1 with mWidthToIndex[0] == 0.
+    // mOffsetX[i] is the width of text.substr(0, i), or NaN if i is not a
+    // grapheme cluster boundary.
+    // Size is text.size() + 1 with mOffsetX[0] == 0.
     std::vector<float> mOffsetX;
     float mAscent {};
     float mDescent {};
+    // The metrics are stale if this does not match the computed style
+    Font mFont;
   };
-  struct UndoableState {
-    enum class Operation {
-      None,
-      Cut,
-      Paste,
-      Typing,
-      DeleteLeft,
-      DeleteRight,
-    };
-    Operation mOperation {Operation::None};
-
+  enum class EditOperation {
+    None,
+    Cut,
+    Paste,
+    Typing,
+    DeleteLeft,
+    DeleteRight,
+  };
+  struct State {
     std::string mText;
     std::size_t mSelectionStart {};
     std::size_t mSelectionEnd {};
   };
+  /* A single step in the undo history.
+   *
+   * Only the changed range is stored; `mRemoved` was replaced by `mInserted`
+   * at `mOffset`.
+   */
+  struct UndoableEdit {
+    EditOperation mOperation {EditOperation::None};
+    std::size_t mOffset {};
+    std::string mRemoved;
+    std::string mInserted;
+    // Restored by undo
+    std::size_t mSelectionStart {};
+    std::size_t mSelectionEnd {};
+
+    /** Extend this edit with `next`, if it continues the same operation.
+     *
+     * For example, typing a word is a single undo step.
+     */
+    [[nodiscard]]
+    bool Merge(const UndoableEdit& next);
+  };
+  static constexpr std::size_t MaxUndoSteps = 100;
   struct Caches {
     felly::unique_ptr<UText, &utext_close> mUText;
     std::wstring mWideText;
+    // Created by the first conversion between UTF-8 and UTF-16 offsets
+    std::optional<detail::Utf16Index> mUtf16Index;
 
     felly::unique_ptr<UBreakIterator, &ubrk_close> mGraphemeIterator;
     felly::unique_ptr<UBreakIterator, &ubrk_close> mWordIterator;
+    // Single-line only
     std::optional<TextMetrics> mTextMetrics;
+    // Multi-line only
+    std::unique_ptr<detail::TextLineLayout> mLineLayout;
   };
 
   Widget* mTextContainer {};
   Widget* mButtons {};
 
-  UndoableState mActiveState {};
-  UndoableState mUndoState {};
+  State mActiveState {};
+  // Most recent last
+  std::deque<UndoableEdit> mUndoStack;
+  std::vector<UndoableEdit> mRedoStack;
 
   mutable Caches mCaches {};
 
   bool mIsFocused {false};
+  bool mIsMultiLine {false};
   std::optional<std::size_t> mMouseSelectionAnchor;
 
   // Caret blinking state
@@ -139,12 +193,61 @@ class TextBox : public Widget, public IFocusable {
 
   // Horizontal scroll position (number of characters hidden off to the left)
   std::size_t mContentScrollX {0};
+  // When moving the caret up or down a line, stay in the same column
+  std::optional<float> mVerticalNavigationX;
+
+  /// Replace `[begin, end)`, and add the change to the undo history
+  void ReplaceText(
+    std::size_t begin,
+    std::size_t end,
+    std::string_view,
+    EditOperation);
+  /** Replace `[begin, end)` without touching the undo history.
+   *
+   * Caches are updated in place rather than discarded.
+   */
+  void SpliceText(std::size_t begin, std::size_t end, std::string_view);
+  // Point the existing `UText` and break iterators at the current text
+  void RetargetIterators() const;
 
-  void BeforeOperation(UndoableState::Operation);
+  // Created for the current text
+  detail::Utf16Index& GetUtf16Index() const;
+  [[nodiscard]]
+  std::size_t ToWideIndex(std::size_t utf8Index) const;
+  [[nodiscard]]
+  std::size_t ToUtf8Index(std::size_t wideIndex) const;
 
   const TextMetrics& GetMetrics() const;
+  // Created or updated for the current font
+  detail::TextLineLayout& GetLineLayout() const;
+  /** Update `mCaches.mTextMetrics` in place after the text has changed.
+   *
+   * The edit replaced `[begin, oldEnd)` with what is now `[begin, newEnd)`;
+   * only the edited range is measured again.
+   */
+  void UpdateMetrics(
+    std::size_t begin,
+    std::size_t oldEnd,
+    std::size_t newEnd) const;
+  // Set `offsets` to NaN for bytes in `[begin, end]` that are not grapheme
+  // cluster boundaries
+  void MaskNonGraphemeBoundaries(
+    std::vector<float>* offsets,
+    std::size_t begin,
+    std::size_t end) const;
 
   void PaintCursor(Renderer*, const Rect&, const Style&) const;
+  void PaintMultiLine(Renderer*, const Style&) const;
+  // The range of visible lines in a multi-line text box
+  [[nodiscard]]
+  std::pair<std::size_t, std::size_t> GetVisibleLines() const;
+  void ScrollCaretIntoView();
+  // The X position to keep when moving the caret up or down
+  [[nodiscard]]
+  float GetVerticalNavigationX() const;
+  // The caret index `lines` lines above or below the caret, nearest to `x`
+  [[nodiscard]]
+  std::size_t GetVerticalNavigationIndex(std::ptrdiff_t lines, float x) const;
 
   UText* GetUText() const noexcept;
   UBreakIterator* GetGraphemeIterator() const noexcept;
@@ -153,8 +256,8 @@ class TextBox : public Widget, public IFocusable {
   std::size_t GetPreviousWordBoundary() const noexcept;
   std::size_t GetNextWordBoundary() const noexcept;
 
-  // Convert an X position in local widget coordinates to a text caret index
-  std::size_t IndexFromLocalX(float x) const noexcept;
+  // Convert a position in local widget coordinates to a text caret index
+  std::size_t IndexFromLocalPoint(const Point&) const noexcept;
 
   static YGSize Measure(
     const YGNode* node,
@@ -171,10 +274,12 @@ class TextBox : public Widget, public IFocusable {
   BoundingBox GetTextBoundingBox(std::size_t begin, std::size_t end)
     const noexcept;
   void SetSelection(std::size_t start, std::size_t end);
+  // Single-line only: adjust `mContentScrollX` to keep the caret visible
+  void UpdateContentScrollX();
   void SetCaret(const std::size_t pos) {
     this->SetSelection(pos, pos);
   }
-  void ReplaceSelection(std::string_view, UndoableState::Operation);
+  void ReplaceSelection(std::string_view, EditOperation);
 };
 
 }// namespace FredEmmott::GUI::Widgets
\ No newline at end of file
@@ -190,6 +190,7 @@ void ToggleSwitchKnob::SetState(const State state) {
     }
     mState = newState;
   }
+  this->InvalidateFrameRateRequirement();
 
   const auto now = std::chrono::steady_clock::now();
   const auto normalEnd = now + ControlNormalAnimationDuration;
@@ -17,6 +17,10 @@ class ToggleSwitchKnob final : public Widget {
   FrameRateRequirement GetFrameRateRequirement() const noexcept override;
   void Tick(const std::chrono::steady_clock::time_point& now) override;
   void PaintOwnContent(Renderer*, const Rect&, const Style&) const override;
+  [[nodiscard]]
+  bool HasVolatilePaint() const noexcept override {
+    return true;
+  }
 
  private:
   enum class State {
@@ -6,6 +6,7 @@
 
 #include <FredEmmott/GUI/FocusManager.hpp>
 #include <FredEmmott/GUI/Point.hpp>
+#include <FredEmmott/GUI/StaticTheme.hpp>
 #include <FredEmmott/GUI/Widgets/Focusable.hpp>
 #include <FredEmmott/GUI/Window.hpp>
 #include <FredEmmott/GUI/assert.hpp>
@@ -14,7 +15,10 @@
 #include <FredEmmott/GUI/events/KeyEvent.hpp>
 #include <FredEmmott/utility/almost_equal.hpp>
 #include <felly/overload.hpp>
+#include <felly/scope_exit.hpp>
+#include <numbers>
 #include <ranges>
+#include <unordered_map>
 
 #include "WidgetList.hpp"
 
@@ -101,6 +105,118 @@ void PaintOutline(
     thickness);
 }
 
+bool IsPainted(const Style& style) {
+  return style.Display() != Display::None
+    && style.Opacity().value_or(1.f) > std::numeric_limits<float>::epsilon();
+}
+
+/// Apply position and transform styles, and return the local content box
+Rect ApplyTransform(
+  Renderer* renderer,
+  const YGNode* yoga,
+  const Style& style) {
+  renderer->Translate(
+    YGNodeLayoutGetLeft(yoga) + style.TranslateX().value_or(0),
+    YGNodeLayoutGetTop(yoga) + style.TranslateY().value_or(0));
+  const Rect rect {Size {
+    YGNodeLayoutGetWidth(yoga),
+    YGNodeLayoutGetHeight(yoga),
+  }};
+  if (
+    style.HasRotate() && !utility::almost_equal(style.Rotate().value(), 0.f)) {
+    renderer->Rotate(
+      style.Rotate().value(),
+      Point {
+        style.TransformOriginX().value_or(0.f) * rect.GetWidth(),
+        style.TransformOriginY().value_or(0.f) * rect.GetHeight(),
+      });
+  }
+
+  const auto scaleX = style.ScaleX().value_or(1.f);
+  const auto scaleY = style.ScaleY().value_or(1.f);
+  if (
+    std::min(scaleX, scaleY) + std::numeric_limits<float>::epsilon() < 1.0f
+    || std::max(scaleX, scaleY)
+      > 1.0f + std::numeric_limits<float>::epsilon()) {
+    const auto oldWidth = rect.GetWidth();
+    const auto oldHeight = rect.GetHeight();
+
+    const auto dx = style.TransformOriginX().value_or(0.f) * oldWidth;
+    const auto dy = style.TransformOriginY().value_or(0.f) * oldHeight;
+
+    renderer->Translate(dx, dy);
+    renderer->Scale(scaleX, scaleY);
+    renderer->Translate(-dx, -dy);
+  }
+  return rect;
+}
+
+/// The area we might paint to, including the outline
+Rect GetInkBounds(const Rect& contentRect, const Style& style) {
+  if (!style.OutlineColor()) {
+    return contentRect;
+  }
+  const auto thickness = style.OutlineWidth().value_or(0);
+  if (thickness < std::numeric_limits<float>::epsilon()) {
+    return contentRect;
+  }
+  const auto outset = [thickness](const float offset) {
+    return std::max(0.f, offset + thickness);
+  };
+  return contentRect.WithOutset(
+    outset(style.OutlineLeftOffset().value_or(0)),
+    outset(style.OutlineTopOffset().value_or(0)),
+    outset(style.OutlineRightOffset().value_or(0)),
+    outset(style.OutlineBottomOffset().value_or(0)));
+}
+
+/** Map a rect from a widget's local coordinates to its parent's.
+ *
+ * This is the bounding box after the same transforms as `ApplyTransform()`.
+ */
+Rect TransformToParent(
+  const YGNode* yoga,
+  const Style& style,
+  const Rect& rect) {
+  const Point offset {
+    YGNodeLayoutGetLeft(yoga) + style.TranslateX().value_or(0),
+    YGNodeLayoutGetTop(yoga) + style.TranslateY().value_or(0),
+  };
+  const Point origin {
+    style.TransformOriginX().value_or(0.f) * YGNodeLayoutGetWidth(yoga),
+    style.TransformOriginY().value_or(0.f) * YGNodeLayoutGetHeight(yoga),
+  };
+  const auto scaleX = style.ScaleX().value_or(1.f);
+  const auto scaleY = style.ScaleY().value_or(1.f);
+  const auto radians = style.HasRotate()
+    ? (style.Rotate().value() * std::numbers::pi_v<float> / 180)
+    : 0.f;
+  const auto cos = std::cos(radians);
+  const auto sin = std::sin(radians);
+
+  Point topLeft {
+    std::numeric_limits<float>::infinity(),
+    std::numeric_limits<float>::infinity(),
+  };
+  Point bottomRight = -topLeft;
+  for (auto&& corner: {
+         rect.GetTopLeft(),
+         rect.GetTopRight(),
+         rect.GetBottomRight(),
+         rect.GetBottomLeft(),
+       }) {
+    // Scale, then rotate, around the transform origin
+    const auto scaled = corner - origin;
+    const Point p {scaled.mX * scaleX, scaled.mY * scaleY};
+    const auto it = offset + origin
+      + Point {(p.mX * cos) - (p.mY * sin), (p.mX * sin) + (p.mY * cos)};
+    topLeft = {std::min(topLeft.mX, it.mX), std::min(topLeft.mY, it.mY)};
+    bottomRight
+      = {std::max(bottomRight.mX, it.mX), std::max(bottomRight.mY, it.mY)};
+  }
+  return {topLeft, bottomRight};
+}
+
 void PaintBorder(
   const YGNode* yoga,
   Renderer* renderer,
@@ -199,8 +315,126 @@ void PaintBorder(
       brush, contentRect.GetBottomLeft(), contentRect.GetTopLeft(), left);
   }
 }
+
+// Whether a child might receive the event as a hit; this matches the test in
+// `DispatchMouseEvent()`
+bool MayContain(const YGNode* child, const MouseEvent& event) {
+  switch (YGNodeStyleGetDisplay(child)) {
+    case YGDisplayNone:
+      return false;
+    case YGDisplayContents:
+      return true;
+    default:
+      break;
+  }
+  const auto [x, y] = event
+                        .WithOffset({
+                          -YGNodeLayoutGetLeft(child),
+                          -YGNodeLayoutGetTop(child),
+                        })
+                        .GetPosition();
+  return x >= 0 && y >= 0 && x < YGNodeLayoutGetWidth(child)
+    && y < YGNodeLayoutGetHeight(child);
+}
 }// namespace
 
+struct Widget::PaintCache {
+  std::unique_ptr<PaintRecording> mRecording;
+  // Brushes are resolved against the theme when painting
+  StaticTheme::Theme mTheme {};
+};
+
+/** Children's layout boxes, sorted along the parent's main axis.
+ *
+ * This lets mouse events find the children under the cursor without
+ * visiting every child; it is rebuilt when the parent has a new layout, as
+ * yoga only repositions children while laying out their parent.
+ */
+struct Widget::HitTestIndex {
+  // Below this, a linear scan is cheaper than maintaining the index
+  static constexpr std::size_t MinimumChildren = 16;
+  // Queries return a superset; children do their own exact test
+  static constexpr float Slack = 1;
+
+  struct Entry {
+    float mBegin {};
+    float mEnd {};
+    float mCrossBegin {};
+    float mCrossEnd {};
+    std::size_t mChildIndex {};
+  };
+
+  bool mIsHorizontal {};
+  // Sorted by `mBegin`
+  std::vector<Entry> mEntries;
+  // `mMaxEnd[i]` is the greatest `mEnd` in `mEntries[0..i]`
+  std::vector<float> mMaxEnd;
+  // Children without a box in our coordinate space that is maintained by our
+  // layout, e.g. `display: contents`, or `LayoutOrphan`s
+  std::vector<std::size_t> mUnindexed;
+
+  void Rebuild(const YGNode* parent, const std::vector<Widget*>& children) {
+    const auto direction = YGNodeStyleGetFlexDirection(parent);
+    mIsHorizontal = direction == YGFlexDirectionRow
+      || direction == YGFlexDirectionRowReverse;
+    mEntries.clear();
+    mUnindexed.clear();
+
+    for (std::size_t i = 0; i < children.size(); ++i) {
+      const auto child = children[i];
+      const auto yoga = child->GetLayoutNode();
+      const auto display = YGNodeStyleGetDisplay(yoga);
+      if (display == YGDisplayNone) {
+        continue;
+      }
+      if (
+        display == YGDisplayContents
+        || child->mClassList.contains(PseudoClasses::LayoutOrphan)) {
+        mUnindexed.push_back(i);
+        continue;
+      }
+      const auto left = YGNodeLayoutGetLeft(yoga);
+      const auto top = YGNodeLayoutGetTop(yoga);
+      const auto right = left + YGNodeLayoutGetWidth(yoga);
+      const auto bottom = top + YGNodeLayoutGetHeight(yoga);
+      if (mIsHorizontal) {
+        mEntries.emplace_back(left, right, top, bottom, i);
+      } else {
+        mEntries.emplace_back(top, bottom, left, right, i);
+      }
+    }
+
+    std::ranges::stable_sort(mEntries, {}, &Entry::mBegin);
+    mMaxEnd.resize(mEntries.size());
+    float maxEnd = -std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i < mEntries.size(); ++i) {
+      maxEnd = std::max(maxEnd, mEntries[i].mEnd);
+      mMaxEnd[i] = maxEnd;
+    }
+  }
+
+  void Query(const Point& point, auto* out) const {
+    const auto main = mIsHorizontal ? point.mX : point.mY;
+    const auto cross = mIsHorizontal ? point.mY : point.mX;
+
+    const auto first = std::ranges::upper_bound(
+      mEntries, main + Slack, {}, &Entry::mBegin);
+    auto i = static_cast<std::size_t>(first - mEntries.begin());
+    while (i-- > 0) {
+      if (mMaxEnd[i] + Slack <= main) {
+        break;
+      }
+      const auto& entry = mEntries[i];
+      if (
+        main < entry.mEnd + Slack && cross >= entry.mCrossBegin - Slack
+        && cross < entry.mCrossEnd + Slack) {
+        out->push_back(entry.mChildIndex);
+      }
+    }
+    out->insert(out->end(), mUnindexed.begin(), mUnindexed.end());
+  }
+};
+
 inline bool Widget::IsMouseButtonSink() const noexcept {
   static constexpr auto TestBits
     = StateFlags::ExplicitMouseButtonSink | StateFlags::ImplicitMouseButtonSink;
@@ -219,6 +453,7 @@ Widget::Widget(
     mYoga(YGNodeNewWithConfig(GetYogaConfig())) {
   AddStyleClass(primaryClass);
   YGNodeSetContext(mYoga.get(), this);
+  YGNodeSetDirtiedFunc(mYoga.get(), &Widget::OnLayoutNodeDirtied);
   mStyleTransitions.reset(new StyleTransitions());
   if (classes.contains(PseudoClasses::ExplicitMouseButtonSink)) {
     mDirectStateFlags |= StateFlags::ExplicitMouseButtonSink;
@@ -239,6 +474,12 @@ Widget* Widget::FromYogaNode(const YGNode* const node) {
   return static_cast<Widget*>(YGNodeGetContext(node));
 }
 
+void Widget::OnLayoutNodeDirtied(const YGNode* const node) {
+  if (const auto self = FromYogaNode(node)) {
+    self->mIntrinsicWidths.reset();
+  }
+}
+
 Widget::~Widget() {
   mDestructionInProgress = true;
   this->EndMouseCapture();
@@ -246,6 +487,7 @@ Widget::~Widget() {
   this->SetStructuralChildren({}, nullptr);
 
   this->GetOwnerWindow()->GetFocusManager()->BeforeDestroy(this);
+  this->GetOwnerWindow()->GetFrameScheduler()->BeforeDestroy(this);
 
   YGNodeSetContext(mYoga.get(), nullptr);
 }
@@ -262,11 +504,10 @@ void Widget::SetImmediateContext(
 }
 
 void Widget::AddStyleClass(const StyleClass klass) {
-  if (mClassList.contains(klass)) {
+  if (!mClassList.emplace(klass)) {
     return;
   }
-  mStylesCacheKey.clear();
-  mClassList.emplace(klass);
+  this->MarkStyleDirty();
 }
 
 void Widget::ToggleStyleClass(const StyleClass klass, const bool value) {
@@ -278,11 +519,10 @@ void Widget::ToggleStyleClass(const StyleClass klass, const bool value) {
     return;
   }
 
-  if (!mClassList.contains(klass)) {
+  if (!mClassList.erase(klass)) {
     return;
   }
-  mClassList.erase(klass);
-  mStylesCacheKey.clear();
+  this->MarkStyleDirty();
 }
 
 bool Widget::IsDisabled() const {
@@ -292,13 +532,14 @@ bool Widget::IsDisabled() const {
 
 FrameRateRequirement Widget::GetFrameRateRequirement() const noexcept {
   using enum StateFlags;
-  // SmoothAnimation is as fast as we can get anyway
   if ((mDirectStateFlags & Animating) != StateFlags::Default) {
     return FrameRateRequirement::SmoothAnimation {};
   }
+  return {};
+}
 
-  return std::views::transform(
-    this->mRawStructuralChildren, &Widget::GetFrameRateRequirement);
+void Widget::InvalidateFrameRateRequirement() {
+  this->GetOwnerWindow()->GetFrameScheduler()->Invalidate(this);
 }
 
 bool Widget::IsDirectlyDisabled() const {
@@ -306,6 +547,10 @@ bool Widget::IsDirectlyDisabled() const {
 }
 
 void Widget::SetIsDirectlyDisabled(bool value) {
+  if (value == IsDirectlyDisabled()) {
+    return;
+  }
+  this->MarkStyleDirty();
   if (value) {
     mDirectStateFlags |= StateFlags::Disabled;
   } else {
@@ -347,10 +592,32 @@ void Widget::SetMutableStyles(const Style& styles) {
     return;
   }
   mMutableStyles = styles;
+  this->MarkStyleDirty();
 }
 
 void Widget::AddMutableStyles(const Style& styles) {
-  mMutableStyles += styles;
+  auto merged = mMutableStyles + styles;
+  if (merged == mMutableStyles) {
+    return;
+  }
+  mMutableStyles = std::move(merged);
+  this->MarkStyleDirty();
+}
+
+void Widget::MarkStyleDirty() {
+  mStyleDirty = true;
+  for (auto it = mStructuralParent; it && !it->mDescendantStyleDirty;
+       it = it->mStructuralParent) {
+    it->mDescendantStyleDirty = true;
+  }
+}
+
+void Widget::MarkSubtreeStyleDirty() {
+  this->MarkStyleDirty();
+  mDescendantStyleDirty = true;
+  for (auto&& child: mRawStructuralChildren) {
+    child->MarkSubtreeStyleDirty();
+  }
 }
 
 void Widget::SetStructuralChildren(
@@ -359,25 +626,28 @@ void Widget::SetStructuralChildren(
   if (children == mRawStructuralChildren) {
     return;
   }
+  this->InvalidatePaint();
+  mHitTestIndexDirty = true;
 
   if (children.empty()) {
+    // Detach the yoga nodes before destroying the children; freeing a node
+    // that still has an owner does a linear search of the owner's children
+    YGNodeSetChildren(mYoga.get(), nullptr, 0);
     mStructuralChildren.clear();
     mRawStructuralChildren.clear();
-    YGNodeSetChildren(mYoga.get(), nullptr, 0);
+    mMouseStateChildren.clear();
     return;
   }
 
   FUI_ASSERT(logicalParent);
-  std::vector<std::unique_ptr<Widget>> ownedChildren;
-  ownedChildren.reserve(children.size());
-  for (auto child: children) {
-    auto it = std::ranges::find(
-      mStructuralChildren, child, &std::unique_ptr<Widget>::get);
-    if (it != mStructuralChildren.end()) {
-      ownedChildren.emplace_back(std::move(*it));
-      continue;
-    }
+  // New children need our inheritable values and state flags
+  this->MarkStyleDirty();
 
+  const auto yoga = mYoga.get();
+  const auto isLayoutChild = [](const Widget* child) {
+    return !child->mClassList.contains(PseudoClasses::LayoutOrphan);
+  };
+  const auto adopt = [this, logicalParent](Widget* child) {
     FUI_ASSERT(
       child->mStructuralParent == nullptr || child->mStructuralParent == this);
     FUI_ASSERT(
@@ -385,77 +655,284 @@ void Widget::SetStructuralChildren(
       || child->mLogicalParent == logicalParent);
     child->mStructuralParent = this;
     child->mLogicalParent = logicalParent;
+  };
+
+  // Fast path: only appending
+  const auto oldCount = mRawStructuralChildren.size();
+  if (
+    children.size() > oldCount
+    && std::ranges::equal(
+      mRawStructuralChildren, children | std::views::take(oldCount))) {
+    for (auto&& child: children | std::views::drop(oldCount)) {
+      adopt(child);
+      mStructuralChildren.emplace_back(child);
+      mRawStructuralChildren.push_back(child);
+      if (isLayoutChild(child)) {
+        YGNodeInsertChild(
+          yoga, child->GetLayoutNode(), YGNodeGetChildCount(yoga));
+      }
+    }
+    return;
+  }
+
+  std::unordered_map<const Widget*, std::size_t> previousIndices;
+  previousIndices.reserve(mStructuralChildren.size());
+  for (std::size_t i = 0; i < mStructuralChildren.size(); ++i) {
+    previousIndices.emplace(mStructuralChildren[i].get(), i);
+  }
+
+  std::vector<std::unique_ptr<Widget>> ownedChildren;
+  ownedChildren.reserve(children.size());
+  for (auto child: children) {
+    if (const auto it = previousIndices.find(child);
+        it != previousIndices.end()) {
+      ownedChildren.push_back(std::move(mStructuralChildren[it->second]));
+      continue;
+    }
+    adopt(child);
     ownedChildren.emplace_back(child);
   }
-  mStructuralChildren = std::move(ownedChildren);
+
+  // Anything left over is no longer a child; these are destroyed when this
+  // goes out of scope, after we're in a consistent state.
+  const auto removed
+    = std::exchange(mStructuralChildren, std::move(ownedChildren));
   mRawStructuralChildren = children;
 
-  std::vector<YGNode*> layoutChildren;
-  layoutChildren.reserve(children.end() - children.begin());
+  mMouseStateChildren.clear();
+  for (std::size_t i = 0; i < children.size(); ++i) {
+    if (children[i]->mHaveMouseState) {
+      mMouseStateChildren.push_back(i);
+    }
+  }
+
+  // Update the yoga children with a few removals, insertions, and moves; this
+  // preserves the cached layout of unchanged siblings. Each of these is
+  // linear in the number of children, so if there are many changes, replace
+  // the whole list in one pass instead.
+  constexpr std::size_t MaxIncrementalEdits = 16;
+  const auto replaceAll = [&] {
+    std::vector<YGNode*> layoutChildren;
+    layoutChildren.reserve(children.size());
+    for (auto&& it: children) {
+      if (isLayoutChild(it)) {
+        layoutChildren.push_back(it->GetLayoutNode());
+      }
+    }
+    YGNodeSetChildren(yoga, layoutChildren.data(), layoutChildren.size());
+  };
+
+  std::size_t edits = 0;
+  for (auto&& child: removed) {
+    if (child && isLayoutChild(child.get())) {
+      ++edits;
+    }
+  }
+  // e.g. clearing or trimming a long list
+  if (edits > MaxIncrementalEdits || edits * 4 > YGNodeGetChildCount(yoga)) {
+    replaceAll();
+    return;
+  }
+  for (auto&& child: removed) {
+    if (child && isLayoutChild(child.get())) {
+      YGNodeRemoveChild(yoga, child->GetLayoutNode());
+    }
+  }
+
+  std::size_t i = 0;
   for (auto&& child: children) {
-    if (!child->mClassList.contains(PseudoClasses::LayoutOrphan)) {
-      layoutChildren.push_back(child->GetLayoutNode());
+    if (!isLayoutChild(child)) {
+      continue;
+    }
+    const auto node = child->GetLayoutNode();
+    if (i < YGNodeGetChildCount(yoga) && YGNodeGetChild(yoga, i) == node) {
+      ++i;
       continue;
     }
+    // Insertions and moves
+    if (++edits > MaxIncrementalEdits) {
+      replaceAll();
+      return;
+    }
+    if (YGNodeGetOwner(node) == yoga) {
+      YGNodeRemoveChild(yoga, node);
+    }
+    YGNodeInsertChild(yoga, node, i++);
   }
-  YGNodeSetChildren(mYoga.get(), layoutChildren.data(), layoutChildren.size());
+  FUI_ASSERT(YGNodeGetChildCount(yoga) == i);
 }
 
 void Widget::Paint(Renderer* renderer) const {
   const auto& style = mComputedStyle;
 
-  if (style.Display() == Display::None) {
+  if (!IsPainted(style)) {
     return;
   }
 
-  const auto opacity = style.Opacity().value_or(1.f);
-  if (opacity <= std::numeric_limits<float>::epsilon()) {
+  const auto layer = renderer->ScopedLayer(style.Opacity().value_or(1.f));
+  const auto yoga = this->GetLayoutNode();
+  const auto rect = ApplyTransform(renderer, yoga, style);
+
+  // Yoga's overflow flag isn't enough here: it ignores absolutely-positioned
+  // children, and paint transforms
+  if (renderer->QuickReject(this->GetSubtreeInkBounds(rect, style))) {
     return;
   }
-  const auto layer = renderer->ScopedLayer(opacity);
+
+  // Clear this before painting children, so that they can re-invalidate us
+  const auto wasDirty = std::exchange(mPaintDirty, false);
+  const FrameProfiler::ScopedWidget profilerScope {this};
+
+  if (mPaintCache) {
+    this->PaintCached(renderer, rect, style, wasDirty);
+  } else {
+    this->PaintUncached(renderer, rect, style);
+  }
+
+  if (this->HasVolatilePaint()) {
+    this->InvalidatePaint();
+  }
+}
+
+void Widget::CollectPaintDamage(Renderer* renderer, Rect* damage) {
   const auto yoga = this->GetLayoutNode();
+  // Yoga marks every node it visits, even if the layout is unchanged; we
+  // compare bounds below instead of treating this as damage.
+  const bool hasNewLayout = YGNodeGetHasNewLayout(yoga);
+  if (hasNewLayout) {
+    YGNodeSetHasNewLayout(yoga, false);
+    mHitTestIndexDirty = true;
+    this->OnLayoutChanged();
+  }
 
-  renderer->Translate(
-    YGNodeLayoutGetLeft(yoga) + style.TranslateX().value_or(0),
-    YGNodeLayoutGetTop(yoga) + style.TranslateY().value_or(0));
-  const Rect rect {Size {
-    YGNodeLayoutGetWidth(yoga),
-    YGNodeLayoutGetHeight(yoga),
-  }};
-  if (
-    style.HasRotate() && !utility::almost_equal(style.Rotate().value(), 0.f)) {
-    renderer->Rotate(
-      style.Rotate().value(),
-      Point {
-        style.TransformOriginX().value_or(0.f) * rect.GetWidth(),
-        style.TransformOriginY().value_or(0.f) * rect.GetHeight(),
-      });
+  if (!(hasNewLayout || mPaintDamaged || mDescendantPaintDamaged)) {
+    return;
   }
 
-  const auto scaleX = style.ScaleX().value_or(1.f);
-  const auto scaleY = style.ScaleY().value_or(1.f);
-  if (
-    std::min(scaleX, scaleY) + std::numeric_limits<float>::epsilon() < 1.0f
-    || std::max(scaleX, scaleY)
-      > 1.0f + std::numeric_limits<float>::epsilon()) {
-    const auto oldWidth = rect.GetWidth();
-    const auto oldHeight = rect.GetHeight();
+  const auto& style = mComputedStyle;
+  if (!IsPainted(style)) {
+    *damage = damage->GetUnion(std::exchange(mPaintedDeviceBounds, {}));
+    // Descendants will be damaged via our bounds if we become visible
+    mPaintDamaged = false;
+    mDescendantPaintDamaged = false;
+    return;
+  }
 
-    const auto dx = style.TransformOriginX().value_or(0.f) * oldWidth;
-    const auto dy = style.TransformOriginY().value_or(0.f) * oldHeight;
+  const auto layer = renderer->ScopedLayer();
+  const auto rect = ApplyTransform(renderer, yoga, style);
 
-    renderer->Translate(dx, dy);
-    renderer->Scale(scaleX, scaleY);
-    renderer->Translate(-dx, -dy);
+  // Includes our children, so that they are damaged if we are hidden or shown
+  const auto bounds
+    = renderer->GetDeviceBounds(this->GetSubtreeInkBounds(rect, style))
+        .GetIntersection(renderer->GetDeviceClipBounds());
+  if (bounds != mPaintedDeviceBounds) {
+    // Moved or resized; also discards recordings
+    this->InvalidatePaint();
   }
+  if (std::exchange(mPaintDamaged, false)) {
+    *damage = damage->GetUnion(mPaintedDeviceBounds).GetUnion(bounds);
+    mPaintedDeviceBounds = bounds;
+  }
+
+  this->CollectChildPaintDamage(renderer, damage);
+  // Cleared last, as children that have moved re-invalidate their ancestors
+  mDescendantPaintDamaged = false;
+}
 
+void Widget::PaintCached(
+  Renderer* renderer,
+  const Rect& rect,
+  const Style& style,
+  const bool isDirty) const {
+  auto& cache = *mPaintCache;
+  const auto theme = StaticTheme::GetCurrent();
+  if (isDirty || theme != cache.mTheme) {
+    cache.mRecording.reset();
+  }
+
+  if (!cache.mRecording) {
+    const auto bounds = this->GetSubtreeInkBounds(rect, style);
+    if (!renderer->BeginRecording(bounds)) {
+      this->PaintUncached(renderer, rect, style);
+      return;
+    }
+    this->PaintUncached(renderer, rect, style);
+    cache.mRecording = renderer->EndRecording();
+    cache.mTheme = theme;
+  }
+
+  renderer->DrawRecording(*cache.mRecording);
+}
+
+void Widget::PaintUncached(
+  Renderer* renderer,
+  const Rect& rect,
+  const Style& style) const {
   PaintBackground(renderer, rect, style);
   this->PaintOwnContent(renderer, rect, style);
   this->PaintChildren(renderer);
-  PaintBorder(yoga, renderer, rect, style);
+  PaintBorder(this->GetLayoutNode(), renderer, rect, style);
   PaintOutline(renderer, rect, style);
 }
 
+void Widget::SetIsPaintCached(const bool value) {
+  if (value == this->IsPaintCached()) {
+    return;
+  }
+  if (value) {
+    mPaintCache = std::make_unique<PaintCache>();
+  } else {
+    mPaintCache.reset();
+  }
+}
+
+void Widget::InvalidatePaint() const noexcept {
+  mPaintDamaged = true;
+  mPaintDirty = true;
+  mChildInkBounds.reset();
+  // Don't stop early if an ancestor is already dirty: culled widgets skip
+  // painting entirely, so may still be dirty when their ancestors are not.
+  for (auto it = mStructuralParent; it; it = it->mStructuralParent) {
+    it->mPaintDirty = true;
+    it->mDescendantPaintDamaged = true;
+    it->mChildInkBounds.reset();
+  }
+}
+
+Rect Widget::GetSubtreeInkBounds(const Rect& contentRect, const Style& style)
+  const {
+  // Yoga marks every node it lays out; `CollectPaintDamage()` clears this,
+  // but visits parents before their children
+  if (!mChildInkBounds || YGNodeGetHasNewLayout(this->GetLayoutNode())) {
+    mChildInkBounds = this->GetChildInkBounds();
+  }
+  return GetInkBounds(contentRect, style).GetUnion(*mChildInkBounds);
+}
+
+Rect Widget::GetChildInkBounds() const {
+  Rect ret {};
+  for (auto&& child: mRawStructuralChildren) {
+    const auto& style = child->mComputedStyle;
+    if (!IsPainted(style)) {
+      continue;
+    }
+    const auto yoga = child->GetLayoutNode();
+    const Rect rect {Size {
+      YGNodeLayoutGetWidth(yoga),
+      YGNodeLayoutGetHeight(yoga),
+    }};
+    ret = ret.GetUnion(
+      TransformToParent(yoga, style, child->GetSubtreeInkBounds(rect, style)));
+  }
+  return ret;
+}
+
+void Widget::CollectChildPaintDamage(Renderer* renderer, Rect* damage) {
+  for (auto&& child: mRawStructuralChildren) {
+    child->CollectPaintDamage(renderer, damage);
+  }
+}
+
 void Widget::PaintChildren(Renderer* renderer) const {
   for (auto&& child: mRawStructuralChildren) {
     child->Paint(renderer);
@@ -560,6 +1037,19 @@ Widget::MouseEventResult Widget::DispatchMouseEvent(
     return {};
   }
 
+  const auto markDirtyIfChanged
+    = felly::scope_exit([this, oldFlags = mDirectStateFlags] {
+        if (((oldFlags ^ mDirectStateFlags) & StyleStateFlags)
+            != StateFlags::None) {
+          this->MarkStyleDirty();
+        }
+      });
+  const auto updateHaveMouseState = felly::scope_exit([this] {
+    mHaveMouseState = !mMouseStateChildren.empty()
+      || (mDirectStateFlags & (StateFlags::Hovered | StateFlags::Active))
+        != StateFlags::None;
+  });
+
   auto event = parentEvent;
 
   const auto layout = this->GetLayoutNode();
@@ -633,12 +1123,22 @@ Widget::MouseEventResult Widget::DispatchMouseEvent(
     this->OnMouseLeave(event);
   }
 
-  // Always propagate unconditionally to allow correct internal states
-  for (auto&& child: mRawStructuralChildren) {
+  // Children that aren't under the mouse only need the event to clear their
+  // hover and active states, so skip those that have nothing to clear
+  const auto children = this->GetMouseEventChildren(event);
+  mMouseStateChildren.clear();
+  for (const auto i: children) {
+    const auto child = mRawStructuralChildren[i];
     if (YGNodeStyleGetDisplay(child->GetLayoutNode()) == YGDisplayNone) {
+      if (child->mHaveMouseState) {
+        mMouseStateChildren.push_back(i);
+      }
       continue;
     }
     const auto it = child->DispatchMouseEvent(event);
+    if (child->mHaveMouseState) {
+      mMouseStateChildren.push_back(i);
+    }
     if (it.mResult == EventHandlerResult::StopPropagation) {
       result = it;
       FUI_ASSERT(it.mTarget);
@@ -692,6 +1192,47 @@ Widget::MouseEventResult Widget::DispatchMouseEvent(
 
   return result;
 }
+
+boost::container::small_vector<std::size_t, 4> Widget::GetMouseEventChildren(
+  const MouseEvent& event) {
+  boost::container::small_vector<std::size_t, 4> ret {
+    mMouseStateChildren.begin(), mMouseStateChildren.end()};
+  if (!event.IsValid()) {
+    return ret;
+  }
+
+  const auto yoga = this->GetLayoutNode();
+  // With `display: contents`, our children are laid out by our parent, so
+  // our new layout flag doesn't tell us when they move
+  if (
+    mRawStructuralChildren.size() < HitTestIndex::MinimumChildren
+    || YGNodeStyleGetDisplay(yoga) == YGDisplayContents) {
+    for (std::size_t i = 0; i < mRawStructuralChildren.size(); ++i) {
+      if (MayContain(mRawStructuralChildren[i]->GetLayoutNode(), event)) {
+        ret.push_back(i);
+      }
+    }
+  } else {
+    if (!mHitTestIndex) {
+      mHitTestIndex = std::make_unique<HitTestIndex>();
+      mHitTestIndexDirty = true;
+    }
+    // `CollectPaintDamage()` usually consumes the flag first, but we might
+    // receive an event between layout and paint
+    if (
+      std::exchange(mHitTestIndexDirty, false)
+      || YGNodeGetHasNewLayout(yoga)) {
+      mHitTestIndex->Rebuild(yoga, mRawStructuralChildren);
+    }
+    mHitTestIndex->Query(event.GetPosition(), &ret);
+  }
+
+  std::ranges::sort(ret);
+  const auto [first, last] = std::ranges::unique(ret);
+  ret.erase(first, last);
+  return ret;
+}
+
 Widget* Widget::DispatchKeyEvent(const KeyEvent& e) {
   auto result = EventHandlerResult::Default;
   if (const auto it = dynamic_cast<const KeyPressEvent*>(&e)) {
@@ -791,6 +1332,10 @@ bool Widget::IsChecked() const noexcept {
 
 void Widget::SetIsChecked(const bool value) {
   using enum StateFlags;
+  if (value == ((mDirectStateFlags & Checked) == Checked)) {
+    return;
+  }
+  this->MarkStyleDirty();
   if (value) {
     mDirectStateFlags |= Checked;
   } else {
@@ -839,7 +1384,8 @@ void Widget::EnsureVisible() {
   }
 
   if (
-    (mDirectStateFlags & StateFlags::HaveFocus) == StateFlags::None
+    mInheritedStyles
+    && (mDirectStateFlags & StateFlags::HaveFocus) == StateFlags::None
     && this->GetOwnerWindow()->GetFocusManager()->IsWidgetFocused(this)) {
     // We need to compute the outline styles so we can compute the rect
     // correctly below
@@ -12,6 +12,7 @@
 #include <FredEmmott/GUI/yoga.hpp>
 #include <boost/container/flat_map.hpp>
 #include <boost/container/small_vector.hpp>
+#include <memory>
 #include <typeindex>
 
 #include "FredEmmott/GUI/events/TextInputEvent.hpp"
@@ -62,6 +63,10 @@ class Widget {
 
   void AddStyleClass(StyleClass);
   void ToggleStyleClass(StyleClass, bool value);
+  [[nodiscard]]
+  StyleClass GetPrimaryStyleClass() const noexcept {
+    return mPrimaryClass;
+  }
 
   // Can return nullptr
   [[nodiscard]]
@@ -157,7 +162,14 @@ class Widget {
     return ret;
   }
 
+  /** The frames this widget needs, not including its children.
+   *
+   * This is only queried after `InvalidateFrameRateRequirement()`, and then
+   * until it no longer requires any frames; see `FrameScheduler`.
+   */
   virtual FrameRateRequirement GetFrameRateRequirement() const noexcept;
+  /// Call when `GetFrameRateRequirement()` may have changed
+  void InvalidateFrameRateRequirement();
 
   /// Whether this widget is disabled, including by a parent
   [[nodiscard]]
@@ -181,13 +193,64 @@ class Widget {
   // A periodic event at an undefined interval; use for animations etc
   virtual void Tick(const std::chrono::steady_clock::time_point& now);
   void ComputeStyles(const Style& inherited);
+  /** Compute styles, sharing an existing inherited-style node.
+   *
+   * Widgets that do not change any inheritable values pass the same node on
+   * to their children, so unchanged subtrees can be detected by pointer
+   * comparison.
+   */
+  void ComputeStyles(std::shared_ptr<const Style> inherited);
   Style FlattenStyles(const Style&);
 
+  /** Mark the computed style as stale.
+   *
+   * `ComputeStyles()` skips widgets - and entire subtrees - that have not been
+   * marked. Changes to classes, state flags, mutable styles, and children mark
+   * the widget automatically; this is for inputs that the widget can not
+   * observe itself, such as focus or theme changes.
+   */
+  void MarkStyleDirty();
+  /// Mark this widget and all of its descendants
+  void MarkSubtreeStyleDirty();
+
   /// User-provided styles
   void SetMutableStyles(const Style& styles);
   void AddMutableStyles(const Style& styles);
 
   void Paint(Renderer* renderer) const;
+  /** Add the device-space areas that need repainting to `damage`.
+   *
+   * This includes both the previous and current bounds of any widgets that
+   * have moved or changed, and must be called after layout, but before
+   * `Paint()`.
+   *
+   * `renderer` is only used for its transform and clip; nothing is drawn.
+   */
+  void CollectPaintDamage(Renderer* renderer, Rect* damage);
+
+  /** Record this widget's painting - including descendants - and replay the
+   * recording until something changes.
+   *
+   * This is worthwhile for large, mostly-static subtrees. Recordings nest, so
+   * when a descendant changes, cached siblings along the way are replayed
+   * rather than repainted.
+   *
+   * It has no effect if the renderer does not support recording. Avoid it for
+   * subtrees containing widgets with volatile paint (e.g. `TextBox` or
+   * `ToggleSwitch`), as they are recorded again on every frame. In the
+   * immediate API, see `.PaintCached()`.
+   */
+  void SetIsPaintCached(bool);
+  [[nodiscard]]
+  bool IsPaintCached() const noexcept {
+    return static_cast<bool>(mPaintCache);
+  }
+  /** Repaint this widget, and discard any recordings that include it.
+   *
+   * Style, layout, and child changes are detected automatically; this is for
+   * other state that affects `PaintOwnContent()`.
+   */
+  void InvalidatePaint() const noexcept;
 
   [[nodiscard]]
   auto GetStructuralChildren() const noexcept {
@@ -283,8 +346,42 @@ class Widget {
     const Style& style,
     StateFlags state);
 
+  /// The inherited-style node for our children, as of the last
+  /// `ComputeStyles()`
+  [[nodiscard]]
+  const std::shared_ptr<const Style>& GetChildInheritedStyles() const noexcept {
+    return mChildInheritedStyles;
+  }
+
+  /// Called before painting if Yoga has calculated a new layout
+  virtual void OnLayoutChanged() {}
+  /** Yoga dirtied callback for this widget's layout node.
+   *
+   * Installed by the constructor; subclasses that replace the callback on
+   * their own or their children's nodes must call this.
+   */
+  static void OnLayoutNodeDirtied(const YGNode*);
   virtual void PaintOwnContent(Renderer*, const Rect&, const Style&) const {}
+  /** Whether `PaintOwnContent()` can change without `InvalidatePaint()`.
+   *
+   * For example, time-based animations, or content that is drawn from state
+   * that the widget does not track changes to.
+   */
+  [[nodiscard]]
+  virtual bool HasVolatilePaint() const noexcept {
+    return false;
+  }
   virtual void PaintChildren(Renderer* canvas) const;
+  /// Must apply the same transforms and clips as `PaintChildren()`
+  virtual void CollectChildPaintDamage(Renderer*, Rect* damage);
+  /** A conservative bound of what `PaintChildren()` might paint.
+   *
+   * This is in our local coordinates, and is used for culling and damage.
+   * Must account for the same transforms and clips as `PaintChildren()`;
+   * if the children are clipped to our box, this can return an empty rect.
+   */
+  [[nodiscard]]
+  virtual Rect GetChildInkBounds() const;
 
   [[nodiscard]]
   virtual EventHandlerResult OnClick(const MouseEvent& e);
@@ -359,21 +456,53 @@ class Widget {
 
   StyleClasses mClassList;
   unique_yoga_node_ptr mYoga;
+  // Only populated while `mYoga` is clean; see `GetIntrinsicWidths()`
+  std::optional<IntrinsicWidths> mIntrinsicWidths;
+  friend IntrinsicWidths FredEmmott::GUI::GetIntrinsicWidths(const YGNode*);
 
   StateFlags mDirectStateFlags {};
   StateFlags mInheritedStateFlags {};
   Style mMutableStyles {};
 
-  std::string mStylesCacheKey;
-  Style mInheritedStyles;
+  // The subset of StateFlags that can affect the computed style
+  static const StateFlags StyleStateFlags;
+  // `StyleStateFlags` as of the last full `ComputeStyles()`
+  StateFlags mStyledStateFlags {};
+  bool mStyleDirty {true};
+  bool mDescendantStyleDirty {true};
+
+  // Immutable and shared; never nullptr after the first `ComputeStyles()`
+  std::shared_ptr<const Style> mInheritedStyles;
+  // What our children inherit; this is the same node as `mInheritedStyles`
+  // unless we override an inheritable value
+  std::shared_ptr<const Style> mChildInheritedStyles;
   Style mComputedStyle;
 
   std::vector<std::unique_ptr<Widget>> mStructuralChildren;
   std::vector<Widget*> mRawStructuralChildren;
 
+  struct PaintCache;
+  std::unique_ptr<PaintCache> mPaintCache;
+  mutable bool mPaintDirty {true};
+  // Device-space bounds as of the last `CollectPaintDamage()`
+  Rect mPaintedDeviceBounds {};
+  // Cached `GetChildInkBounds()`; reset by `InvalidatePaint()` and by layout
+  mutable std::optional<Rect> mChildInkBounds;
+  mutable bool mPaintDamaged {true};
+  mutable bool mDescendantPaintDamaged {true};
+
   boost::container::small_flat_map<std::type_index, std::unique_ptr<Context>, 2>
     mContexts;
 
+  struct HitTestIndex;
+  std::unique_ptr<HitTestIndex> mHitTestIndex;
+  bool mHitTestIndexDirty {true};
+  // Indices of structural children which have hovered or active widgets in
+  // their subtree, as of the last `DispatchMouseEvent()`
+  boost::container::small_vector<std::size_t, 2> mMouseStateChildren;
+  // This widget or a descendant is hovered or active
+  bool mHaveMouseState {false};
+
   Point mMouseCaptureOffset {};
 
   [[nodiscard]]
@@ -389,9 +518,24 @@ class Widget {
     return const_cast<Widget*>(this)->GetStructuralParentForLogicalChildren();
   }
 
+  /// Our ink bounds, and the cached ink bounds of our children
+  [[nodiscard]]
+  Rect GetSubtreeInkBounds(const Rect& contentRect, const Style&) const;
+  void PaintCached(Renderer*, const Rect&, const Style&, bool isDirty) const;
+  void PaintUncached(Renderer*, const Rect&, const Style&) const;
+
   // Returns the innermost widget that received the event.
   [[nodiscard]]
   MouseEventResult DispatchMouseEvent(const MouseEvent&);
+  /** Indices of the children that `DispatchMouseEvent()` needs to visit.
+   *
+   * These are the children that might contain the event's point, and those
+   * that need their hover or active state clearing; the result is in
+   * structural order.
+   */
+  [[nodiscard]]
+  boost::container::small_vector<std::size_t, 4> GetMouseEventChildren(
+    const MouseEvent&);
   Widget* DispatchKeyEvent(const KeyEvent&);
   Widget* DispatchTextInputEvent(const TextInputEvent&);
 
@@ -401,6 +545,17 @@ class Widget {
   bool MatchesStyleClass(const StyleClass&) const;
   [[nodiscard]]
   bool MatchesStyleSelector(Style::Selector) const;
+  /** Key for `ImmutableStyle::GetCached()`, if the immutable and baseline
+   * styles can be cached.
+   */
+  [[nodiscard]]
+  std::optional<uint64_t> GetStyleCacheKey() const;
+  /** `GlobalBaselineStyle + mImmutableStyle`, flattened for this widget.
+   *
+   * Returns nullptr if there is no immutable style.
+   */
+  [[nodiscard]]
+  std::shared_ptr<const Style> GetFlattenedImmutableStyle();
 
   void SetStructuralChildren(
     const std::vector<Widget*>& children,
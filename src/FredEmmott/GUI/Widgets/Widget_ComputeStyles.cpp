@@ -7,6 +7,7 @@
 #include <FredEmmott/GUI/Window.hpp>
 #include <FredEmmott/GUI/assert.hpp>
 #include <FredEmmott/GUI/detail/Widget/transitions.hpp>
+#include <bit>
 #include <felly/overload.hpp>
 
 #include "Widget.hpp"
@@ -17,6 +18,11 @@ namespace FredEmmott::GUI::Widgets {
 using namespace widget_detail;
 
 namespace {
+const Style& GetGlobalBaselineStyle() {
+  static const auto ret = Style::BuiltinBaseline();
+  return ret;
+}
+
 template <style_detail::StylePropertyKey P>
 constexpr auto default_v = style_detail::default_property_value_v<P>;
 
@@ -94,8 +100,21 @@ constexpr auto MakeYogaValue(const PositionType v) {
 
 }// namespace
 
+const Widget::StateFlags Widget::StyleStateFlags = StateFlags::Disabled
+  | StateFlags::Hovered | StateFlags::Active | StateFlags::Checked
+  | StateFlags::HaveFocus | StateFlags::HaveVisibleFocus;
+
 void Widget::ComputeStyles(const Style& inherited) {
-  static const auto GlobalBaselineStyle = Style::BuiltinBaseline();
+  if (mInheritedStyles && *mInheritedStyles == inherited) {
+    this->ComputeStyles(mInheritedStyles);
+    return;
+  }
+  this->ComputeStyles(std::make_shared<const Style>(inherited));
+}
+
+void Widget::ComputeStyles(std::shared_ptr<const Style> inherited) {
+  FUI_ASSERT(inherited);
+  const auto& GlobalBaselineStyle = GetGlobalBaselineStyle();
 
   const auto fm = this->GetOwnerWindow()->GetFocusManager();
   FUI_ASSERT(fm);
@@ -109,28 +128,37 @@ void Widget::ComputeStyles(const Style& inherited) {
     }
   }
 
-  if (mStylesCacheKey.empty()) {
-    mStylesCacheKey.resize(sizeof(void*) * (mClassList.size() + 1));
-    const auto cacheKeyPointers
-      = reinterpret_cast<uintptr_t*>(mStylesCacheKey.data());
-    std::ranges::copy(
-      mClassList | std::views::transform(&StyleClass::AsCacheKey),
-      cacheKeyPointers + 1);
+  const auto styledStateFlags
+    = (mDirectStateFlags | mInheritedStateFlags) & StyleStateFlags;
+  if (
+    styledStateFlags != mStyledStateFlags
+    || !mInheritedStyles
+    || (inherited != mInheritedStyles && *inherited != *mInheritedStyles)) {
+    mStyleDirty = true;
   }
-  reinterpret_cast<uintptr_t*>(mStylesCacheKey.data())[0]
-    = static_cast<uintptr_t>(mDirectStateFlags | mInheritedStateFlags);
-
-  auto flattened = mImmutableStyle.GetCached(mStylesCacheKey);
-  if (!flattened) {
-    if (mImmutableStyle) {
-      flattened = FlattenStyles(GlobalBaselineStyle + mImmutableStyle.Get());
-      mImmutableStyle.EmplaceCache(mStylesCacheKey, *flattened);
-    } else {
-      flattened = GlobalBaselineStyle;
+
+  if (!mStyleDirty) {
+    // Our inheritable values are unchanged, so our children's
+    // `mInheritedStyles` are still correct, and usually the same node as our
+    // `mChildInheritedStyles`
+    if (std::exchange(mDescendantStyleDirty, false)) {
+      for (auto&& child: mRawStructuralChildren) {
+        // New children have not inherited anything yet
+        child->ComputeStyles(
+          child->mInheritedStyles ? child->mInheritedStyles
+                                  : mChildInheritedStyles);
+      }
     }
+    return;
   }
+  mStyleDirty = false;
+  mDescendantStyleDirty = false;
+  mStyledStateFlags = styledStateFlags;
+  FrameProfiler::Count(WidgetCounter::StylesRecomputed, this);
 
-  auto style = flattened.value() + inherited + mMutableStyles;
+  const auto flattened = this->GetFlattenedImmutableStyle();
+  auto style = (flattened ? *flattened : GlobalBaselineStyle) + *inherited
+    + mMutableStyles;
 
   mDirectStateFlags &= ~StateFlags::Animating;
 
@@ -184,21 +212,39 @@ void Widget::ComputeStyles(const Style& inherited) {
 
   if (mComputedStyle != Style {}) {
     if (
-      mStyleTransitions->Apply(mComputedStyle, &style)
+      mStyleTransitions->Apply(
+        this->GetOwnerWindow()->GetTransitionEngine(), mComputedStyle, &style)
       == StyleTransitions::ApplyResult::Animating) {
       mDirectStateFlags |= StateFlags::Animating;
     }
   }
 
-  mInheritedStyles = inherited;
-  mComputedStyle = style;
+  // If our computed style is unchanged, so is what our children inherit
+  const bool styleChanged = (style != mComputedStyle);
+  if (styleChanged) {
+    this->InvalidatePaint();
+  }
+  if (styleChanged || !mChildInheritedStyles) {
+    auto childStyles = style.InheritableValues();
+    if (childStyles == *inherited) {
+      // We don't override anything inheritable, so share our parent's node
+      mChildInheritedStyles = inherited;
+    } else if (
+      !(mChildInheritedStyles && *mChildInheritedStyles == childStyles)) {
+      mChildInheritedStyles
+        = std::make_shared<const Style>(std::move(childStyles));
+    }
+  }
+  mInheritedStyles = std::move(inherited);
+  mComputedStyle = std::move(style);
 
-  const auto childStyles = style.InheritableValues();
   for (auto&& child: mRawStructuralChildren) {
-    child->ComputeStyles(childStyles);
+    child->ComputeStyles(mChildInheritedStyles);
   }
 
   const auto yoga = this->GetLayoutNode();
+  // Yoga only marks the node as dirty if a value actually changes
+  const bool wasLayoutDirty = YGNodeIsDirty(yoga);
   const auto setYoga
     = [&]<class... FrontArgs>(
         const auto defaultValue,
@@ -268,6 +314,58 @@ void Widget::ComputeStyles(const Style& inherited) {
   X(Top, Position, YGEdgeTop)
   X(Width, Width)
 #undef X
+  if (!wasLayoutDirty && YGNodeIsDirty(yoga)) {
+    FrameProfiler::Count(WidgetCounter::YogaNodesDirtied, this);
+  }
+
+  // Transitions are evaluated in `ComputeStyles()`, so we need to run again
+  // next frame
+  if ((mDirectStateFlags & StateFlags::Animating) != StateFlags::None) {
+    this->MarkStyleDirty();
+    this->InvalidateFrameRateRequirement();
+  }
+}
+
+std::shared_ptr<const Style> Widget::GetFlattenedImmutableStyle() {
+  if (!mImmutableStyle) {
+    return nullptr;
+  }
+
+  const auto cacheKey = this->GetStyleCacheKey();
+  if (cacheKey) {
+    if (auto cached = mImmutableStyle.GetCached(*cacheKey)) {
+      return cached;
+    }
+    FrameProfiler::Count(WidgetCounter::StyleCacheMisses, this);
+  }
+
+  auto flattened
+    = FlattenStyles(GetGlobalBaselineStyle() + mImmutableStyle.Get());
+  if (!cacheKey) {
+    return std::make_shared<const Style>(std::move(flattened));
+  }
+  return mImmutableStyle.EmplaceCache(*cacheKey, std::move(flattened));
+}
+
+std::optional<uint64_t> Widget::GetStyleCacheKey() const {
+  static const StyleSelectorSet BaselineSelectors {GetGlobalBaselineStyle()};
+  const auto& selectors = mImmutableStyle.GetSelectors();
+  if (!(BaselineSelectors.IsCacheable() && selectors.IsCacheable())) {
+    return std::nullopt;
+  }
+  if (BaselineSelectors.GetClassCount() + selectors.GetClassCount() > 64) {
+    return std::nullopt;
+  }
+
+  const auto matches = [this](const StyleClass klass) {
+    return this->MatchesStyleClass(klass);
+  };
+  auto ret = BaselineSelectors.GetMatchMask(matches);
+  if (selectors.GetClassCount() == 0) {
+    return ret;
+  }
+  ret |= selectors.GetMatchMask(matches) << BaselineSelectors.GetClassCount();
+  return ret;
 }
 
 Style Widget::FlattenStyles(const Style& inputStyle) {
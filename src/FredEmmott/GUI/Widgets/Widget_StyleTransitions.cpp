@@ -69,12 +69,12 @@ Widget::StyleTransitions::ApplyResult Widget::StyleTransitions::Apply(
   constexpr auto DefaultValue = transition_default_value_v<TValue>;
 
   if (!oldStyle.mStorage.contains(key)) {
-    mTransitions.erase(key);
+    this->Erase(key);
     return NotAnimating;
   }
 
   if (!newStyle->mStorage.contains(key)) {
-    mTransitions.erase(key);
+    this->Erase(key);
     return NotAnimating;
   }
 
@@ -85,12 +85,12 @@ Widget::StyleTransitions::ApplyResult Widget::StyleTransitions::Apply(
   //  1. Do we have a start, an end, and an animation? //
   ///////////////////////////////////////////////////////
   if (!(oldProp || newProp)) {
-    mTransitions.erase(key);
+    this->Erase(key);
     return NotAnimating;
   }
 
   if (!newProp.has_transition()) {
-    mTransitions.erase(key);
+    this->Erase(key);
     return NotAnimating;
   }
 
@@ -98,7 +98,7 @@ Widget::StyleTransitions::ApplyResult Widget::StyleTransitions::Apply(
   if (
     newProp.transition().mDuration.count() == 0
     && newProp.transition().mDelay.count() == 0) {
-    mTransitions.erase(key);
+    this->Erase(key);
     return NotAnimating;
   }
 
@@ -119,7 +119,7 @@ Widget::StyleTransitions::ApplyResult Widget::StyleTransitions::Apply(
       // for animatable properties
       __debugbreak();
     }
-    mTransitions.erase(key);
+    this->Erase(key);
     return NotAnimating;
   }
 
@@ -132,7 +132,7 @@ Widget::StyleTransitions::ApplyResult Widget::StyleTransitions::Apply(
 
   if (almost_equal(startValue, endValue)) {
     newProp = endValue;
-    mTransitions.erase(key);
+    this->Erase(key);
     return NotAnimating;
   }
 
@@ -145,21 +145,24 @@ Widget::StyleTransitions::ApplyResult Widget::StyleTransitions::Apply(
     = newProp.transition().mDuration * AnimationDurationMultiplier;
 
   if (!mTransitions.contains(key)) {
-    TransitionState<TValue> state {
+    EngineTransitionState<TValue> state {
       .mStartValue = startValue,
       .mStartTime = now + transition.mDelay,
       .mEndValue = endValue,
       .mEndTime = now + transition.mDelay + duration,
     };
-    newProp = state.Evaluate(transition.mEasingFunction, now);
+    state.Start(mEngine, transition.mEasingFunction);
+    newProp = state.Evaluate(*mEngine);
     if (almost_equal(newProp.value(), endValue)) {
+      mEngine->Release(state.mHandle);
       return NotAnimating;
     }
     mTransitions.emplace(key, std::move(state));
     return Animating;
   }
 
-  auto& transitionState = get<TransitionState<TValue>>(mTransitions.at(key));
+  auto& transitionState
+    = get<EngineTransitionState<TValue>>(mTransitions.at(key));
 
   // Target value has changed, so we need to update the animation
   if (!almost_equal(transitionState.mEndValue, endValue)) {
@@ -171,7 +174,9 @@ Widget::StyleTransitions::ApplyResult Widget::StyleTransitions::Apply(
       .mStartTime = now + delay,
       .mEndValue = endValue,
       .mEndTime = std::max(transitionState.mEndTime, now + delay + duration),
+      .mHandle = transitionState.mHandle,
     };
+    transitionState.Start(mEngine, transition.mEasingFunction);
     newProp = oldProp.value();
 
     return Animating;
@@ -181,12 +186,13 @@ Widget::StyleTransitions::ApplyResult Widget::StyleTransitions::Apply(
   //  4. Use the current animation //
   ///////////////////////////////////
 
-  newProp = transitionState.Evaluate(transition.mEasingFunction, now);
+  // Evaluated by `TransitionEngine::Update()`
+  newProp = transitionState.Evaluate(*mEngine);
 
   // Has it finished?
   if (almost_equal(newProp.value(), endValue)) {
     newProp = endValue;
-    mTransitions.erase(key);
+    this->Erase(key);
     return NotAnimating;
   }
 
@@ -197,14 +203,51 @@ Widget::StyleTransitions::ApplyResult Widget::StyleTransitions::Apply(
   return Animating;
 }
 
+Widget::StyleTransitions::~StyleTransitions() {
+  if (!mEngine) {
+    return;
+  }
+  for (auto&& [key, state]: mTransitions) {
+    std::visit(
+      [this](const auto& it) {
+        if constexpr (requires { it.mHandle; }) {
+          mEngine->Release(it.mHandle);
+        }
+      },
+      state);
+  }
+}
+
+void Widget::StyleTransitions::Erase(const StylePropertyKey key) {
+  const auto it = mTransitions.find(key);
+  if (it == mTransitions.end()) {
+    return;
+  }
+  std::visit(
+    [this](const auto& state) {
+      if constexpr (requires { state.mHandle; }) {
+        mEngine->Release(state.mHandle);
+      }
+    },
+    it->second);
+  mTransitions.erase(it);
+}
+
 Widget::StyleTransitions::ApplyResult Widget::StyleTransitions::Apply(
+  TransitionEngine* const engine,
   const Style& oldStyle,
   Style* newStyle) {
   using enum ApplyResult;
   if (!SystemSettings::Get().GetAnimationsEnabled()) {
     return NotAnimating;
   }
-  const auto now = std::chrono::steady_clock::now();
+  FUI_ASSERT(engine);
+  FUI_ASSERT(
+    mEngine == nullptr || mEngine == engine,
+    "Widgets can not move between windows");
+  mEngine = engine;
+  // Sampled once per frame by the engine, rather than per widget
+  const auto now = engine->GetNow();
 
   auto ret = NotAnimating;
 
@@ -3,6 +3,7 @@
 #include "Window.hpp"
 
 #include <FredEmmott/GUI/StaticTheme/Generic.hpp>
+#include <cmath>
 #include <thread>
 
 #include "FredEmmott/GUI/events/KeyEvent.hpp"
@@ -13,6 +14,22 @@
 
 namespace FredEmmott::GUI {
 
+namespace {
+Rect RoundOutDamage(const Rect& damage) {
+  if (damage.IsEmpty()) {
+    return {};
+  }
+  // Anti-aliasing can touch the pixels just outside of the geometry
+  return {
+    Point {std::floor(damage.GetLeft()) - 1, std::floor(damage.GetTop()) - 1},
+    Point {
+      std::ceil(damage.GetRight()) + 1,
+      std::ceil(damage.GetBottom()) + 1,
+    },
+  };
+}
+}// namespace
+
 Window::Window(
   Widgets::Widget* actualRoot,
   Widgets::Widget* immediateRoot,
@@ -34,14 +51,20 @@ std::expected<void, int> Window::BeginFrame() {
   }
   using namespace Immediate::immediate_detail;
 
-  mBeginFrameTime = std::chrono::steady_clock::now();
-  this->ProcessNativeEvents();
+  mBeginFrameTime = this->GetClockNow();
+  mProfiler.BeginFrame();
+  {
+    const FrameProfiler::ScopedPhase phase {FramePhase::ProcessNativeEvents};
+    this->ProcessNativeEvents();
+  }
   if (mExitCode.has_value()) {
+    mProfiler.CancelFrame();
     return std::unexpected {mExitCode.value()};
   }
   FUI_ASSERT(!tWindow);
   tWindow = this;
   mFUIRoot.BeginFrame();
+  mProfiler.BeginPhase(FramePhase::UserCallback);
   return {};
 }
 
@@ -77,7 +100,7 @@ void Window::WaitFrame(unsigned int minFPS, unsigned int maxFPS) const {
     : mBeginFrameTime + std::chrono::microseconds {1'000'000 / minFPS};
   thisFrameAt = std::clamp(thisFrameAt, lowerBound, upperBound);
 
-  const auto now = std::chrono::steady_clock::now();
+  const auto now = this->GetClockNow();
   if (thisFrameAt < now) {
     return;
   }
@@ -87,7 +110,13 @@ void Window::WaitFrame(unsigned int minFPS, unsigned int maxFPS) const {
 
 void Window::EndFrame() {
   using namespace Immediate::immediate_detail;
-  mFUIRoot.EndFrame();
+  mProfiler.EndPhase(FramePhase::UserCallback);
+  const auto endProfilerFrame
+    = felly::scope_exit([this] { mProfiler.EndFrame(); });
+  {
+    const FrameProfiler::ScopedPhase phase {FramePhase::Reconcile};
+    mFUIRoot.EndFrame(this->GetClockNow());
+  }
 
   FUI_ASSERT(tWindow == this, "Improperly nested windows");
   const auto resetWindowAtExit = felly::scope_exit([] { tWindow = nullptr; });
@@ -97,9 +126,9 @@ void Window::EndFrame() {
     return;
   }
 
-  if (!this->GetNativeHandle()) [[unlikely]] {
+  if (!this->IsWindowInitialized()) [[unlikely]] {
     this->InitializeWindow();
-    if (!this->GetNativeHandle()) {
+    if (!this->IsWindowInitialized()) {
       mExitCode = EXIT_FAILURE;
       return;
     }
@@ -130,7 +159,7 @@ void Window::EndFrame() {
 }
 
 FrameRateRequirement Window::GetFrameRateRequirement() const {
-  return mFUIRoot.GetFrameRateRequirement();
+  return mFUIRoot.GetFrameRateRequirement(this->GetClockNow());
 }
 
 void Window::SetDefaultAction(const std::function<void()>& action) {
@@ -146,30 +175,86 @@ Widgets::Widget* Window::GetRootWidget() const noexcept {
 FocusManager* Window::GetFocusManager() const noexcept {
   return GetRoot()->GetFocusManager();
 }
+FrameScheduler* Window::GetFrameScheduler() const noexcept {
+  return GetRoot()->GetFrameScheduler();
+}
+TransitionEngine* Window::GetTransitionEngine() const noexcept {
+  return GetRoot()->GetTransitionEngine();
+}
 
 void Window::Paint() {
   this->ResizeIfNeeded();
 
+  auto painter = this->GetFramePainter(mFrameIndex);
   {
-    const auto painter = this->GetFramePainter(mFrameIndex);
     const auto renderer = painter->GetRenderer();
     const auto layer = renderer->ScopedLayer();
-    renderer->Clear(this->GetClearColor());
-    renderer->Scale(this->GetDPIScale());
-    mFUIRoot.Paint(renderer, this->GetCanvasSize());
-    if (IsDisabled()) {
-      const auto theme = StaticTheme::GetCurrent();
+
+    const CanvasState canvas {
+      .mSize = this->GetCanvasSize(),
+      .mDPIScale = this->GetDPIScale(),
+      .mTheme = StaticTheme::GetCurrent(),
+      .mClearColor = this->GetClearColor(),
+      .mIsDisabled = this->IsDisabled(),
+    };
+
+    Rect damage;
+    {
+      const auto layoutLayer = renderer->ScopedLayer();
+      renderer->Scale(canvas.mDPIScale);
+      damage = mFUIRoot.UpdateLayout(
+        renderer, canvas.mSize, this->GetClockNow());
+    }
+    if (mProfiler.IsOverlayVisible()) {
+      const auto overlay = FrameProfiler::GetOverlayRect();
+      damage = damage.GetUnion({
+        Point {
+          overlay.GetLeft() * canvas.mDPIScale,
+          overlay.GetTop() * canvas.mDPIScale,
+        },
+        Size {
+          overlay.GetWidth() * canvas.mDPIScale,
+          overlay.GetHeight() * canvas.mDPIScale,
+        },
+      });
+    }
+    if (!this->IsCanvasRetained() || canvas != mPaintedCanvasState) {
+      damage = Rect {Size {
+        canvas.mSize.mWidth * canvas.mDPIScale,
+        canvas.mSize.mHeight * canvas.mDPIScale,
+      }};
+    } else {
+      damage = RoundOutDamage(damage);
+    }
+    mPaintedCanvasState = canvas;
+    mFrameDamage = damage;
+
+    const FrameProfiler::ScopedPhase phase {FramePhase::Paint};
+    const auto clipToDamage = renderer->ScopedClipRect(damage);
+    renderer->Clear(canvas.mClearColor);
+    renderer->Scale(canvas.mDPIScale);
+    mFUIRoot.Paint(renderer, canvas.mSize);
+    if (canvas.mIsDisabled) {
       renderer->FillRect(
-        StaticTheme::Common::SmokeFillColorDefaultBrush.Resolve(theme),
-        this->GetCanvasSize());
+        StaticTheme::Common::SmokeFillColorDefaultBrush.Resolve(canvas.mTheme),
+        canvas.mSize);
+    }
+    if (mProfiler.IsOverlayVisible()) {
+      mProfiler.PaintOverlay(renderer);
     }
   }
+  {
+    // Backends submit the frame when the painter is destroyed
+    const FrameProfiler::ScopedPhase phase {FramePhase::Present};
+    painter.reset();
+  }
 
   mFrameIndex = (mFrameIndex + 1) % mSwapChainLength;
 }
 
 void Window::ResetToFirstBackBuffer() {
   mFrameIndex = 0;
+  mPaintedCanvasState.reset();
 }
 
 Widgets::Widget* Window::DispatchEvent(const MouseEvent& e) {
@@ -8,8 +8,11 @@
 #include <expected>
 #include <memory>
 
+#include "Color.hpp"
+#include "FrameProfiler.hpp"
 #include "Immediate/Root.hpp"
 #include "Point.hpp"
+#include "Rect.hpp"
 #include "WindowBackdrop.hpp"
 
 namespace FredEmmott::GUI::Widgets {
@@ -99,6 +102,15 @@ class Window {
   Widgets::Widget* GetRootWidget() const noexcept;
   [[nodiscard]]
   FocusManager* GetFocusManager() const noexcept;
+  [[nodiscard]]
+  FrameScheduler* GetFrameScheduler() const noexcept;
+  [[nodiscard]]
+  TransitionEngine* GetTransitionEngine() const noexcept;
+
+  [[nodiscard]]
+  FrameProfiler* GetProfiler() noexcept {
+    return &mProfiler;
+  }
 
  protected:
   virtual void SetBackdrop(const WindowBackdrop&) = 0;
@@ -113,6 +125,27 @@ class Window {
   virtual Color GetClearColor() const = 0;
   virtual void InitializeGraphicsAPI() = 0;
   virtual void InitializeWidgetTree() {}
+  /** Whether the canvas keeps its content between frames.
+   *
+   * If so, only the damaged area of the canvas is repainted each frame.
+   */
+  [[nodiscard]]
+  virtual bool IsCanvasRetained() const noexcept {
+    return false;
+  }
+  /// Whether `InitializeWindow()` has succeeded
+  [[nodiscard]]
+  virtual bool IsWindowInitialized() const noexcept {
+    return static_cast<bool>(this->GetNativeHandle());
+  }
+  /** The time used for frame timing and animations.
+   *
+   * This can be overridden for deterministic rendering, e.g. in tests.
+   */
+  [[nodiscard]]
+  virtual std::chrono::steady_clock::time_point GetClockNow() const {
+    return std::chrono::steady_clock::now();
+  }
   /** Wait for any of:
    *
    * - `InterruptWaitFrame()`
@@ -142,6 +175,15 @@ class Window {
 
   void ResetToFirstBackBuffer();
 
+  /** The area of the canvas that was repainted by the last `Paint()`.
+   *
+   * This is in device pixels, and may be empty.
+   */
+  [[nodiscard]]
+  const Rect& GetFrameDamage() const noexcept {
+    return mFrameDamage;
+  }
+
   void DispatchEvent(const KeyEvent&);
   void DispatchEvent(const TextInputEvent&);
   Widgets::Widget* DispatchEvent(const MouseEvent& e);
@@ -154,6 +196,20 @@ class Window {
 
   std::optional<int> mExitCode;
   Immediate::Root mFUIRoot;
+  FrameProfiler mProfiler;
+
+  // Anything that changes the entire canvas
+  struct CanvasState {
+    Size mSize;
+    float mDPIScale {};
+    StaticTheme::Theme mTheme {};
+    Color mClearColor;
+    bool mIsDisabled {};
+
+    bool operator==(const CanvasState&) const noexcept = default;
+  };
+  std::optional<CanvasState> mPaintedCanvasState;
+  Rect mFrameDamage;
 
   std::function<void()> mDefaultAction;
   std::function<void()> mCancelAction;
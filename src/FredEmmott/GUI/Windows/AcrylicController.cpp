@@ -15,6 +15,7 @@
 #include <windows.ui.composition.interop.h>
 #include <wrl.h>
 
+#include <bit>
 #include <random>
 
 #include "FredEmmott/GUI/Brush.hpp"
@@ -19,6 +19,7 @@
 #include <thread>
 
 #include "FredEmmott/GUI/detail/renderer_detail.hpp"
+#include "FredEmmott/GUI/detail/skia_detail.hpp"
 #include "FredEmmott/GUI/detail/win32_detail/CopySoftwareBitmap.hpp"
 
 #if __has_include(<skia/gpu/ganesh/GrDirectContext.h>)
@@ -39,32 +40,6 @@ namespace FredEmmott::GUI {
 namespace {
 using namespace win32_detail;
 
-struct SkiaFontMetricsProvider final : renderer_detail::FontMetricsProvider {
-  ~SkiaFontMetricsProvider() override = default;
-
-  float MeasureTextWidth(const Font& font, const std::string_view text)
-    const override {
-    if (!font) {
-      return std::numeric_limits<float>::quiet_NaN();
-    }
-    const auto it = font.as<SkFont>();
-    return it.measureText(text.data(), text.size(), SkTextEncoding::kUTF8);
-  }
-
-  Font::Metrics GetFontMetrics(const Font& font) const override {
-    using namespace font_detail;
-    const auto it = font.as<SkFont>();
-    SkFontMetrics pt {};
-    const auto lineSpacingPt = it.getMetrics(&pt);
-    return {
-      .mSize = it.getSize(),
-      .mLineSpacing = lineSpacingPt,
-      .mAscent = pt.fAscent,
-      .mDescent = pt.fDescent,
-    };
-  }
-};
-
 void ConfigureD3DDebugLayer(
   [[maybe_unused]] const wil::com_ptr<ID3D12Device>& device) {
   if constexpr (Config::Debug) {
@@ -310,7 +285,7 @@ Win32Direct3D12GaneshWindow::Win32Direct3D12GaneshWindow(
   SetRenderAPI(
     RenderAPI::Skia,
     "Skia(Ganesh)+D3D12",
-    std::make_unique<SkiaFontMetricsProvider>());
+    skia_detail::CreateFontMetricsProvider());
 }
 
 Win32Direct3D12GaneshWindow::~Win32Direct3D12GaneshWindow() {
@@ -418,6 +393,9 @@ void Win32Direct3D12GaneshWindow::AfterPaintFrame(
 
   const auto d3d11 = mSharedResources->mD3D11DeviceContext.get();
   CheckHResult(d3d11->Wait(mInteropFence.mD3D11Fence.get(), interopFenceValue));
+  // Even if only `GetFrameDamage()` was repainted, we need to copy everything:
+  // the swap chain uses `DXGI_SWAP_EFFECT_FLIP_DISCARD`, so the back buffer
+  // contents are undefined.
   d3d11->CopySubresourceRegion(
     mFrame.mD3D11SwapChainTexture.get(),
     0,
@@ -40,6 +40,11 @@ class Win32Direct3D12GaneshWindow final : public Win32Window {
   IUnknown* GetGPUDeviceForComposition() const override;
   void CreateRenderTargets() override;
   void CleanupFrameContexts() override;
+  // Skia draws to a persistent texture, which is then copied to the swap chain
+  [[nodiscard]]
+  bool IsCanvasRetained() const noexcept override {
+    return true;
+  }
   std::unique_ptr<Win32Window> CreatePopup(
     HINSTANCE instance,
     int showCommand,
@@ -0,0 +1,326 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include "TextLineLayout.hpp"
+
+#include <FredEmmott/GUI/assert.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace FredEmmott::GUI::detail {
+
+namespace {
+constexpr bool IsHorizontalWhitespace(const char c) {
+  return c == ' ' || c == '\t';
+}
+
+[[nodiscard]]
+float NormalizeWrapWidth(const float width) {
+  if (std::isnan(width) || std::isinf(width) || width <= 0) {
+    return 0;
+  }
+  return width;
+}
+}// namespace
+
+TextLineLayout::TextLineLayout(
+  const Font& font,
+  const std::string_view text,
+  const float wrapWidth)
+  : mFont(font),
+    mWrapWidth(NormalizeWrapWidth(wrapWidth)) {
+  const auto metrics = font.GetMetrics();
+  mLineHeight = metrics.mLineSpacing;
+  // Ascent is negative
+  const auto glyphHeight = metrics.mDescent - metrics.mAscent;
+  mBaseline = ((mLineHeight - glyphHeight) / 2) - metrics.mAscent;
+
+  UErrorCode status = U_ZERO_ERROR;
+  mUText.reset(utext_openUTF8(nullptr, "", 0, &status));
+  mGraphemeIterator.reset(
+    ubrk_open(UBRK_CHARACTER, nullptr, nullptr, 0, &status));
+  mLineIterator.reset(ubrk_open(UBRK_LINE, nullptr, nullptr, 0, &status));
+
+  mParagraphs = this->MakeParagraphs(text, 0, text.size());
+  this->UpdateParagraphs(0, 0, 0);
+}
+
+TextLineLayout::~TextLineLayout() = default;
+
+void TextLineLayout::Update(
+  const std::string_view text,
+  const std::size_t begin,
+  const std::size_t oldEnd,
+  const std::size_t newEnd) {
+  FUI_ASSERT(begin <= oldEnd && begin <= newEnd);
+
+  // Everything before `begin` is unchanged, so paragraph offsets are still
+  // valid for the search
+  const auto first = this->GetParagraphIndex(begin);
+  const auto last = this->GetParagraphIndex(oldEnd);
+  const auto rangeBegin = mParagraphs[first].mBegin;
+  const auto oldRangeEnd = mParagraphs[last].mBegin + mParagraphs[last].mLength;
+  const auto newRangeEnd = (oldRangeEnd + newEnd) - oldEnd;
+
+  auto replacement = this->MakeParagraphs(text, rangeBegin, newRangeEnd);
+  const auto oldCount = (last - first) + 1;
+  const auto firstUnchanged = first + replacement.size();
+  if (replacement.size() == oldCount) {
+    std::ranges::move(replacement, mParagraphs.begin() + first);
+  } else {
+    mParagraphs.erase(
+      mParagraphs.begin() + first, mParagraphs.begin() + last + 1);
+    mParagraphs.insert(
+      mParagraphs.begin() + first,
+      std::make_move_iterator(replacement.begin()),
+      std::make_move_iterator(replacement.end()));
+  }
+
+  this->UpdateParagraphs(first, firstUnchanged, newEnd - oldEnd);
+}
+
+void TextLineLayout::SetWrapWidth(float width) {
+  width = NormalizeWrapWidth(width);
+  if (width == mWrapWidth) {
+    return;
+  }
+  mWrapWidth = width;
+  for (auto&& paragraph: mParagraphs) {
+    this->Wrap(&paragraph);
+  }
+  this->UpdateParagraphs(0, 0, 0);
+}
+
+std::size_t TextLineLayout::GetLineCount() const noexcept {
+  FUI_ASSERT(!mParagraphs.empty());
+  const auto& last = mParagraphs.back();
+  return last.mFirstLine + last.mLineStarts.size();
+}
+
+float TextLineLayout::GetNaturalWidth() const noexcept {
+  float ret = 0;
+  for (auto&& paragraph: mParagraphs) {
+    ret = std::max(ret, paragraph.mOffsetX.back());
+  }
+  return ret;
+}
+
+TextLineLayout::Line TextLineLayout::GetLine(
+  const std::size_t lineIndex) const {
+  const auto& p = mParagraphs[this->GetParagraphIndexForLine(lineIndex)];
+  const auto i = lineIndex - p.mFirstLine;
+  const auto end
+    = (i + 1 < p.mLineStarts.size()) ? p.mLineStarts[i + 1] : p.mLength;
+  return {
+    .mBegin = p.mBegin + p.mLineStarts[i],
+    .mEnd = p.mBegin + end,
+    .mTop = mLineHeight * lineIndex,
+  };
+}
+
+std::size_t TextLineLayout::GetLineIndex(const std::size_t index) const {
+  const auto& p = mParagraphs[this->GetParagraphIndex(index)];
+  const auto it = std::ranges::upper_bound(p.mLineStarts, index - p.mBegin);
+  return p.mFirstLine + (it - p.mLineStarts.begin()) - 1;
+}
+
+float TextLineLayout::GetOffsetX(
+  const std::size_t lineIndex,
+  const std::size_t index) const {
+  const auto& p = mParagraphs[this->GetParagraphIndexForLine(lineIndex)];
+  const auto lineStart = p.mLineStarts[lineIndex - p.mFirstLine];
+  FUI_ASSERT(index >= p.mBegin + lineStart);
+
+  const auto& x = p.mOffsetX;
+  auto i = std::min(index - p.mBegin, p.mLength);
+  while (i > lineStart && std::isnan(x[i])) {
+    --i;
+  }
+  return x[i] - x[lineStart];
+}
+
+Point TextLineLayout::GetCaretPoint(const std::size_t index) const {
+  const auto line = this->GetLineIndex(index);
+  return {
+    this->GetOffsetX(line, index),
+    mLineHeight * line,
+  };
+}
+
+std::size_t TextLineLayout::GetIndexAtPoint(const Point& point) const {
+  const auto lineCount = this->GetLineCount();
+  const auto lineIndex = (point.mY <= 0)
+    ? 0
+    : std::min(
+        static_cast<std::size_t>(point.mY / mLineHeight), lineCount - 1);
+
+  const auto& p = mParagraphs[this->GetParagraphIndexForLine(lineIndex)];
+  const auto i = lineIndex - p.mFirstLine;
+  const auto lineStart = p.mLineStarts[i];
+  const bool isWrapped = (i + 1 < p.mLineStarts.size());
+  // The end of a wrapped line is the start of the next line, so we stop just
+  // before it
+  const auto lineEnd = isWrapped ? p.mLineStarts[i + 1] - 1 : p.mLength;
+
+  const auto& x = p.mOffsetX;
+  const auto origin = x[lineStart];
+  auto ret = lineStart;
+  auto closest = std::numeric_limits<float>::infinity();
+  for (auto j = lineStart; j <= lineEnd; ++j) {
+    if (std::isnan(x[j])) {
+      continue;
+    }
+    const auto offset = x[j] - origin;
+    const auto distance = std::abs(offset - point.mX);
+    if (distance < closest) {
+      closest = distance;
+      ret = j;
+    }
+    if (offset >= point.mX) {
+      break;
+    }
+  }
+  return p.mBegin + ret;
+}
+
+void TextLineLayout::Measure(Paragraph* p, const std::string_view text) {
+  const auto content = text.substr(p->mBegin, p->mLength);
+  p->mOffsetX = mFont.MeasureTextOffsets(content);
+
+  // Re-targeting the iterators is cheap; opening them loads the break rules
+  UErrorCode status = U_ZERO_ERROR;
+  utext_openUTF8(mUText.get(), content.data(), content.size(), &status);
+
+  const auto graphemes = mGraphemeIterator.get();
+  ubrk_setUText(graphemes, mUText.get(), &status);
+  auto& x = p->mOffsetX;
+  for (auto previous = ubrk_first(graphemes), next = ubrk_next(graphemes);
+       next != UBRK_DONE;
+       previous = next, next = ubrk_next(graphemes)) {
+    std::fill(
+      x.begin() + previous + 1,
+      x.begin() + next,
+      std::numeric_limits<float>::signaling_NaN());
+  }
+
+  const auto lines = mLineIterator.get();
+  ubrk_setUText(lines, mUText.get(), &status);
+  p->mBreaks.clear();
+  for (auto next = ubrk_following(lines, 0);
+       next != UBRK_DONE && static_cast<std::size_t>(next) < p->mLength;
+       next = ubrk_next(lines)) {
+    auto visibleEnd = static_cast<std::size_t>(next);
+    while (visibleEnd > 0 && IsHorizontalWhitespace(content[visibleEnd - 1])) {
+      --visibleEnd;
+    }
+    p->mBreaks.push_back({static_cast<std::size_t>(next), visibleEnd});
+  }
+}
+
+void TextLineLayout::Wrap(Paragraph* p) const {
+  p->mLineStarts.assign(1, 0);
+  if (mWrapWidth <= 0) {
+    return;
+  }
+
+  const auto& x = p->mOffsetX;
+  const auto& breaks = p->mBreaks;
+  auto nextBreak = breaks.begin();
+  std::size_t lineStart = 0;
+  while (x[p->mLength] - x[lineStart] > mWrapWidth) {
+    // Greedy: take the last break that fits
+    std::size_t wrapAt = lineStart;
+    for (; nextBreak != breaks.end(); ++nextBreak) {
+      if (nextBreak->mIndex <= lineStart) {
+        continue;
+      }
+      if (x[nextBreak->mVisibleEnd] - x[lineStart] > mWrapWidth) {
+        break;
+      }
+      wrapAt = nextBreak->mIndex;
+    }
+
+    if (wrapAt == lineStart) {
+      // A single word is wider than the line, so break it between grapheme
+      // clusters; there is always at least one per line
+      for (auto i = lineStart + 1; i <= p->mLength; ++i) {
+        if (std::isnan(x[i])) {
+          continue;
+        }
+        if (wrapAt > lineStart && x[i] - x[lineStart] > mWrapWidth) {
+          break;
+        }
+        wrapAt = i;
+      }
+      if (wrapAt >= p->mLength) {
+        return;
+      }
+    }
+
+    p->mLineStarts.push_back(wrapAt);
+    lineStart = wrapAt;
+  }
+}
+
+void TextLineLayout::UpdateParagraphs(
+  const std::size_t first,
+  const std::size_t firstMoved,
+  const std::size_t delta) {
+  std::size_t line = 0;
+  if (first > 0) {
+    const auto& previous = mParagraphs[first - 1];
+    line = previous.mFirstLine + previous.mLineStarts.size();
+  }
+  for (auto i = first; i < mParagraphs.size(); ++i) {
+    auto& p = mParagraphs[i];
+    if (i >= firstMoved) {
+      // Unsigned wraparound gives the right result if text was removed
+      p.mBegin += delta;
+    }
+    p.mFirstLine = line;
+    line += p.mLineStarts.size();
+  }
+}
+
+std::size_t TextLineLayout::GetParagraphIndex(const std::size_t index) const {
+  const auto it
+    = std::ranges::upper_bound(mParagraphs, index, {}, &Paragraph::mBegin);
+  FUI_ASSERT(it != mParagraphs.begin());
+  return static_cast<std::size_t>(it - mParagraphs.begin()) - 1;
+}
+
+std::size_t TextLineLayout::GetParagraphIndexForLine(
+  const std::size_t lineIndex) const {
+  const auto it = std::ranges::upper_bound(
+    mParagraphs, lineIndex, {}, &Paragraph::mFirstLine);
+  FUI_ASSERT(it != mParagraphs.begin());
+  return static_cast<std::size_t>(it - mParagraphs.begin()) - 1;
+}
+
+std::vector<TextLineLayout::Paragraph> TextLineLayout::MakeParagraphs(
+  const std::string_view text,
+  const std::size_t begin,
+  const std::size_t end) {
+  std::vector<Paragraph> ret;
+  const auto range = text.substr(0, end);
+  auto paragraphBegin = begin;
+  while (true) {
+    const auto newline = range.find('\n', paragraphBegin);
+    const auto paragraphEnd
+      = (newline == std::string_view::npos) ? end : newline;
+
+    auto& p = ret.emplace_back();
+    p.mBegin = paragraphBegin;
+    p.mLength = paragraphEnd - paragraphBegin;
+    this->Measure(&p, text);
+    this->Wrap(&p);
+
+    if (paragraphEnd == end) {
+      return ret;
+    }
+    paragraphBegin = paragraphEnd + 1;
+  }
+}
+
+}// namespace FredEmmott::GUI::detail
@@ -0,0 +1,161 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FredEmmott/GUI/Font.hpp>
+#include <FredEmmott/GUI/Point.hpp>
+#include <felly/unique_ptr.hpp>
+#include <string_view>
+#include <vector>
+
+#include "icu.hpp"
+
+namespace FredEmmott::GUI::detail {
+
+/** Incremental layout for multi-line, word-wrapped text.
+ *
+ * The text is split into paragraphs at `\n`. Each paragraph is measured once,
+ * then wrapped into lines using its cached caret offsets and line break
+ * opportunities:
+ *
+ * - edits only measure the paragraphs they touch again
+ * - changing the wrap width wraps every paragraph again, but does not measure
+ *   any text
+ *
+ * Indices are UTF-8 byte offsets into the full text. A caret index at a wrap
+ * point belongs to the second line.
+ */
+class TextLineLayout final {
+ public:
+  struct Line {
+    std::size_t mBegin {};
+    // Excludes the trailing `\n`, if any
+    std::size_t mEnd {};
+    float mTop {};
+  };
+
+  /// `wrapWidth` <= 0 disables wrapping
+  TextLineLayout(const Font&, std::string_view text, float wrapWidth);
+  ~TextLineLayout();
+
+  TextLineLayout(const TextLineLayout&) = delete;
+  TextLineLayout& operator=(const TextLineLayout&) = delete;
+
+  [[nodiscard]]
+  const Font& GetFont() const noexcept {
+    return mFont;
+  }
+
+  [[nodiscard]]
+  float GetLineHeight() const noexcept {
+    return mLineHeight;
+  }
+
+  /// The distance from the top of a line to its baseline
+  [[nodiscard]]
+  float GetBaseline() const noexcept {
+    return mBaseline;
+  }
+
+  /** Update the layout after an edit.
+   *
+   * `[begin, oldEnd)` was replaced with what is now `[begin, newEnd)` of
+   * `text`.
+   */
+  void Update(
+    std::string_view text,
+    std::size_t begin,
+    std::size_t oldEnd,
+    std::size_t newEnd);
+
+  /// Wrap again if the width changed; text is not measured again
+  void SetWrapWidth(float);
+
+  [[nodiscard]]
+  float GetWrapWidth() const noexcept {
+    return mWrapWidth;
+  }
+
+  [[nodiscard]]
+  std::size_t GetLineCount() const noexcept;
+
+  [[nodiscard]]
+  float GetHeight() const noexcept {
+    return mLineHeight * this->GetLineCount();
+  }
+
+  /// The width of the widest paragraph, ignoring wrapping
+  [[nodiscard]]
+  float GetNaturalWidth() const noexcept;
+
+  [[nodiscard]]
+  Line GetLine(std::size_t lineIndex) const;
+  /// The index of the line containing caret index `index`
+  [[nodiscard]]
+  std::size_t GetLineIndex(std::size_t index) const;
+
+  /// The X offset of caret index `index` from the start of line `lineIndex`
+  [[nodiscard]]
+  float GetOffsetX(std::size_t lineIndex, std::size_t index) const;
+  /// The top of the caret at `index`, relative to the top-left of the text
+  [[nodiscard]]
+  Point GetCaretPoint(std::size_t index) const;
+  /// The closest caret index to `point`, relative to the top-left of the text
+  [[nodiscard]]
+  std::size_t GetIndexAtPoint(const Point&) const;
+
+ private:
+  struct Break {
+    // Where the next line would start
+    std::size_t mIndex {};
+    // `mIndex`, excluding trailing whitespace, which may overhang the edge
+    std::size_t mVisibleEnd {};
+  };
+
+  // Positions are relative to `mBegin`
+  struct Paragraph {
+    std::size_t mBegin {};
+    // Excludes the `\n`
+    std::size_t mLength {};
+    std::size_t mFirstLine {};
+
+    // Caret offsets, as in `TextBox`; NaN if not a grapheme cluster boundary
+    std::vector<float> mOffsetX;
+    std::vector<Break> mBreaks;
+    // Always starts with 0
+    std::vector<std::size_t> mLineStarts;
+  };
+
+  Font mFont;
+  float mLineHeight {};
+  float mBaseline {};
+  float mWrapWidth {};
+  std::vector<Paragraph> mParagraphs;
+
+  felly::unique_ptr<UText, &utext_close> mUText;
+  felly::unique_ptr<UBreakIterator, &ubrk_close> mGraphemeIterator;
+  felly::unique_ptr<UBreakIterator, &ubrk_close> mLineIterator;
+
+  void Measure(Paragraph*, std::string_view text);
+  void Wrap(Paragraph*) const;
+  /** Update the positions of `mParagraphs[first]` onwards.
+   *
+   * `delta` is added to `mBegin` for `mParagraphs[firstMoved]` onwards.
+   */
+  void UpdateParagraphs(
+    std::size_t first,
+    std::size_t firstMoved,
+    std::size_t delta);
+
+  [[nodiscard]]
+  std::size_t GetParagraphIndex(std::size_t index) const;
+  [[nodiscard]]
+  std::size_t GetParagraphIndexForLine(std::size_t lineIndex) const;
+
+  // Split `text[begin, end)` into paragraphs, and measure them
+  [[nodiscard]]
+  std::vector<Paragraph>
+  MakeParagraphs(std::string_view text, std::size_t begin, std::size_t end);
+};
+
+}// namespace FredEmmott::GUI::detail
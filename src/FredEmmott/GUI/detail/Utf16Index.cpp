@@ -0,0 +1,150 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include "Utf16Index.hpp"
+
+#include <FredEmmott/GUI/assert.hpp>
+#include <algorithm>
+#include <cstdint>
+
+namespace FredEmmott::GUI::detail {
+
+namespace {
+constexpr bool IsContinuationByte(const char c) {
+  return (static_cast<uint8_t>(c) & 0xc0) == 0x80;
+}
+
+// Code points that need 4 bytes in UTF-8 need a surrogate pair in UTF-16
+constexpr std::size_t GetUtf16Length(const char leadByte) {
+  return (static_cast<uint8_t>(leadByte) >= 0xf0) ? 2 : 1;
+}
+
+[[nodiscard]]
+std::size_t CountUtf16(const std::string_view text) {
+  std::size_t ret = 0;
+  for (const auto c: text) {
+    if (!IsContinuationByte(c)) {
+      ret += GetUtf16Length(c);
+    }
+  }
+  return ret;
+}
+}// namespace
+
+Utf16Index::Utf16Index(const std::string_view text)
+  : mChunks(MakeChunks(text)) {
+  if (mChunks.empty()) {
+    mChunks.emplace_back();
+  }
+}
+
+void Utf16Index::Update(
+  const std::string_view text,
+  const std::size_t begin,
+  const std::size_t oldEnd,
+  const std::size_t newEnd) {
+  FUI_ASSERT(begin <= oldEnd && begin <= newEnd);
+
+  // Chunk lengths before `begin` are unchanged, so they are still valid for
+  // the search
+  const auto first = this->FindUtf8(begin);
+  const auto last = this->FindUtf8(oldEnd);
+  const auto rangeBegin = first.mUtf8Begin;
+  auto lastIndex = last.mChunk;
+  auto oldRangeEnd = last.mUtf8Begin + mChunks[lastIndex].mUtf8Length;
+  // Merge with the next chunk if deletions have made this one small
+  while (lastIndex + 1 < mChunks.size()
+         && ((oldRangeEnd + newEnd) - oldEnd) - rangeBegin < ChunkSize / 2) {
+    ++lastIndex;
+    oldRangeEnd += mChunks[lastIndex].mUtf8Length;
+  }
+  const auto newRangeEnd = (oldRangeEnd + newEnd) - oldEnd;
+
+  const auto replacement
+    = MakeChunks(text.substr(rangeBegin, newRangeEnd - rangeBegin));
+  const auto oldCount = (lastIndex - first.mChunk) + 1;
+  if (replacement.size() == oldCount) {
+    std::ranges::copy(replacement, mChunks.begin() + first.mChunk);
+    return;
+  }
+  mChunks.erase(
+    mChunks.begin() + first.mChunk, mChunks.begin() + lastIndex + 1);
+  mChunks.insert(
+    mChunks.begin() + first.mChunk, replacement.begin(), replacement.end());
+  if (mChunks.empty()) {
+    mChunks.emplace_back();
+  }
+}
+
+std::size_t Utf16Index::ToUtf16(
+  const std::string_view text,
+  const std::size_t index) const {
+  FUI_ASSERT(index <= text.size());
+  const auto position = this->FindUtf8(index);
+  return position.mUtf16Begin
+    + CountUtf16(
+           text.substr(position.mUtf8Begin, index - position.mUtf8Begin));
+}
+
+std::size_t Utf16Index::ToUtf8(
+  const std::string_view text,
+  const std::size_t index) const {
+  std::size_t utf8Begin = 0;
+  std::size_t utf16Begin = 0;
+  for (std::size_t i = 0; i + 1 < mChunks.size(); ++i) {
+    const auto& chunk = mChunks[i];
+    if (index < utf16Begin + chunk.mUtf16Length) {
+      break;
+    }
+    utf8Begin += chunk.mUtf8Length;
+    utf16Begin += chunk.mUtf16Length;
+  }
+
+  auto ret = utf8Begin;
+  auto remaining = index - std::min(index, utf16Begin);
+  while (remaining > 0 && ret < text.size()) {
+    const auto length = GetUtf16Length(text[ret]);
+    if (length > remaining) {
+      // Between the two halves of a surrogate pair
+      break;
+    }
+    remaining -= length;
+    ++ret;
+    while (ret < text.size() && IsContinuationByte(text[ret])) {
+      ++ret;
+    }
+  }
+  return ret;
+}
+
+Utf16Index::Position Utf16Index::FindUtf8(const std::size_t index) const {
+  Position ret {};
+  for (; ret.mChunk + 1 < mChunks.size(); ++ret.mChunk) {
+    const auto& chunk = mChunks[ret.mChunk];
+    if (index < ret.mUtf8Begin + chunk.mUtf8Length) {
+      break;
+    }
+    ret.mUtf8Begin += chunk.mUtf8Length;
+    ret.mUtf16Begin += chunk.mUtf16Length;
+  }
+  return ret;
+}
+
+std::vector<Utf16Index::Chunk> Utf16Index::MakeChunks(
+  const std::string_view text) {
+  std::vector<Chunk> ret;
+  ret.reserve((text.size() / ChunkSize) + 1);
+  std::size_t begin = 0;
+  while (begin < text.size()) {
+    auto end = std::min(begin + ChunkSize, text.size());
+    while (end < text.size() && IsContinuationByte(text[end])) {
+      ++end;
+    }
+    const auto chunk = text.substr(begin, end - begin);
+    ret.push_back({chunk.size(), CountUtf16(chunk)});
+    begin = end;
+  }
+  return ret;
+}
+
+}// namespace FredEmmott::GUI::detail
@@ -0,0 +1,71 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+namespace FredEmmott::GUI::detail {
+
+/** Converts between UTF-8 and UTF-16 offsets into the same text.
+ *
+ * The text is split into chunks of roughly `ChunkSize` bytes, and the UTF-16
+ * length of each chunk is cached:
+ *
+ * - conversions skip whole chunks, then count within a single chunk
+ * - edits only count the chunks they touch again
+ *
+ * Finding a chunk is a linear search of the chunk table, which is
+ * `ChunkSize` times smaller than the text.
+ *
+ * The text is not stored; it must be passed to every call, and must be the
+ * text that the index was last created or updated for.
+ */
+class Utf16Index final {
+ public:
+  Utf16Index() = delete;
+  explicit Utf16Index(std::string_view text);
+
+  /** Update the index after an edit.
+   *
+   * `[begin, oldEnd)` was replaced with what is now `[begin, newEnd)` of
+   * `text`.
+   */
+  void Update(
+    std::string_view text,
+    std::size_t begin,
+    std::size_t oldEnd,
+    std::size_t newEnd);
+
+  /// The UTF-16 offset of UTF-8 offset `index`
+  [[nodiscard]]
+  std::size_t ToUtf16(std::string_view text, std::size_t index) const;
+  /// The UTF-8 offset of UTF-16 offset `index`
+  [[nodiscard]]
+  std::size_t ToUtf8(std::string_view text, std::size_t index) const;
+
+ private:
+  static constexpr std::size_t ChunkSize = 1024;
+
+  struct Chunk {
+    std::size_t mUtf8Length {};
+    std::size_t mUtf16Length {};
+  };
+  // Never empty; empty text has a single empty chunk
+  std::vector<Chunk> mChunks;
+
+  struct Position {
+    std::size_t mChunk {};
+    std::size_t mUtf8Begin {};
+    std::size_t mUtf16Begin {};
+  };
+  // The last chunk containing UTF-8 offset `index`
+  [[nodiscard]]
+  Position FindUtf8(std::size_t index) const;
+
+  // Split `text` into chunks that start on code point boundaries
+  [[nodiscard]]
+  static std::vector<Chunk> MakeChunks(std::string_view text);
+};
+
+}// namespace FredEmmott::GUI::detail
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include <FredEmmott/GUI/TransitionEngine.hpp>
 #include <FredEmmott/GUI/Widgets/Widget.hpp>
 #include <FredEmmott/GUI/detail/widget_detail.hpp>
 
@@ -68,6 +69,65 @@ struct TransitionState<T> {
   }
 };
 
+/// A style transition that is evaluated by a `TransitionEngine`
+template <class T>
+struct EngineTransitionState;
+
+template <class T>
+  requires(!StyleProperty<T>::SupportsTransitions)
+struct EngineTransitionState<T> : std::monostate {};
+
+template <class T>
+  requires StyleProperty<T>::SupportsTransitions
+struct EngineTransitionState<T> {
+  using value_type = T;
+  using time_point = std::chrono::steady_clock::time_point;
+
+  T mStartValue {};
+  time_point mStartTime;
+  T mEndValue {};
+  time_point mEndTime;
+
+  TransitionEngine::Handle mHandle {};
+
+  void Start(TransitionEngine* engine, const EasingFunction& easingFunction) {
+    if constexpr (std::same_as<T, float>) {
+      mHandle = engine->Start(
+        mHandle, mStartValue, mEndValue, mStartTime, mEndTime, easingFunction);
+      return;
+    } else {
+      if constexpr (std::same_as<T, Brush>) {
+        const auto start = mStartValue.GetSolidColor();
+        const auto end = mEndValue.GetSolidColor();
+        if (start && end) {
+          mHandle = engine->Start(
+            mHandle, *start, *end, mStartTime, mEndTime, easingFunction);
+          return;
+        }
+      }
+      // No lane for this type; the engine tracks the progress, and we
+      // interpolate in `Evaluate()`
+      mHandle = engine->Start(
+        mHandle, 0.0f, 1.0f, mStartTime, mEndTime, easingFunction);
+    }
+  }
+
+  [[nodiscard]]
+  T Evaluate(const TransitionEngine& engine) const {
+    if constexpr (std::same_as<T, float>) {
+      return engine.GetFloat(mHandle);
+    } else {
+      if constexpr (std::same_as<T, Brush>) {
+        if (mHandle.GetValueType() == TransitionEngine::ValueType::Color) {
+          return engine.GetColor(mHandle);
+        }
+      }
+      return Interpolation::Linear(
+        mStartValue, mEndValue, engine.GetProgress(mHandle));
+    }
+  }
+};
+
 }// namespace FredEmmott::GUI::Widgets::widget_detail
 
 namespace FredEmmott::GUI::Widgets {
@@ -77,8 +137,17 @@ struct Widget::StyleTransitions {
     NotAnimating,
     Animating,
   };
+
+  StyleTransitions() = default;
+  ~StyleTransitions();
+  StyleTransitions(const StyleTransitions&) = delete;
+  StyleTransitions& operator=(const StyleTransitions&) = delete;
+
   [[nodiscard]]
-  ApplyResult Apply(const Style& oldStyle, Style* newStyle);
+  ApplyResult Apply(
+    TransitionEngine* engine,
+    const Style& oldStyle,
+    Style* newStyle);
 
  private:
   template <class TValue>
@@ -93,12 +162,17 @@ struct Widget::StyleTransitions {
     Style* newStyle,
     style_detail::StylePropertyKey);
 
+  void Erase(style_detail::StylePropertyKey);
+
+  // Set by the first `Apply()`; owned by our window
+  TransitionEngine* mEngine {nullptr};
+
   utility::unordered_map<
     style_detail::StylePropertyKey,
     utility::drop_last_t<
       std::variant,
 #define DECLARE_TRANSITION_DATA(TYPE, NAME) \
-  widget_detail::TransitionState<TYPE>,
+  widget_detail::EngineTransitionState<TYPE>,
       FUI_ENUM_STYLE_PROPERTY_TYPES(DECLARE_TRANSITION_DATA)
 #undef DECLARE_TRANSITION_DATA
         void>>
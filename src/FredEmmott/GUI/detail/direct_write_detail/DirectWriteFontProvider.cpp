@@ -3,6 +3,7 @@
 #include "DirectWriteFontProvider.hpp"
 
 #include <FredEmmott/GUI/detail/win32_detail.hpp>
+#include <algorithm>
 
 namespace FredEmmott::GUI::direct_write_detail {
 using namespace win32_detail;
@@ -44,6 +45,97 @@ float DirectWriteFontProvider::MeasureTextWidth(
   return metrics.widthIncludingTrailingWhitespace;
 }
 
+std::vector<float> DirectWriteFontProvider::MeasureTextOffsets(
+  const Font& font,
+  const std::string_view text) const {
+  using namespace font_detail;
+  std::vector<float> ret(
+    text.size() + 1, std::numeric_limits<float>::quiet_NaN());
+  if (text.empty()) {
+    ret.front() = 0.0f;
+    return ret;
+  }
+  if (!font) [[unlikely]] {
+    return ret;
+  }
+  const auto wideText = win32_detail::Utf8ToWide(text);
+
+  const auto props = font.as<DirectWriteFont>();
+
+  wil::com_ptr<IDWriteTextLayout> textLayout;
+  if (FAILED(mDWriteFactory->CreateTextLayout(
+        wideText.c_str(),
+        static_cast<UINT32>(wideText.length()),
+        props.mTextFormat.get(),
+        // Use a large width to ensure text is not wrapped
+        FLT_MAX,
+        // Height doesn't matter for width measurement
+        FLT_MAX,
+        textLayout.put()))) {
+    return ret;
+  }
+
+  UINT32 clusterCount {};
+  // Fails with E_NOT_SUFFICIENT_BUFFER, but gives us the count
+  textLayout->GetClusterMetrics(nullptr, 0, &clusterCount);
+  std::vector<DWRITE_CLUSTER_METRICS> clusters(clusterCount);
+  if (FAILED(textLayout->GetClusterMetrics(
+        clusters.data(), clusterCount, &clusterCount))) {
+    return ret;
+  }
+
+  float x = 0;
+  std::size_t byte = 0;
+  for (const auto& cluster: clusters) {
+    // Clusters are measured in UTF-16 code units. Clusters can contain
+    // multiple characters, e.g. ligatures, so we place carets inside them
+    // proportionally.
+    UINT16 units = 0;
+    while (units < cluster.length && byte < text.size()) {
+      ret[byte] = x + ((cluster.width * units) / cluster.length);
+      const auto length = std::min(
+        renderer_detail::GetUTF8SequenceLength(text[byte]),
+        text.size() - byte);
+      units += (length == 4) ? 2 : 1;
+      byte += length;
+    }
+    x += cluster.width;
+  }
+  ret.back() = x;
+
+  return ret;
+}
+
+ShapedText DirectWriteFontProvider::ShapeText(
+  const Font& font,
+  const std::string_view text) const {
+  using namespace font_detail;
+  if (!font) [[unlikely]] {
+    return {};
+  }
+  if (text.empty()) {
+    return {font, 0.0f, wil::com_ptr<IDWriteTextLayout> {}};
+  }
+  const auto wideText = win32_detail::Utf8ToWide(text);
+
+  const auto props = font.as<DirectWriteFont>();
+
+  wil::com_ptr<IDWriteTextLayout> textLayout;
+  CheckHResult(mDWriteFactory->CreateTextLayout(
+    wideText.c_str(),
+    static_cast<UINT32>(wideText.length()),
+    props.mTextFormat.get(),
+    // Use a large width to ensure text is not wrapped
+    FLT_MAX,
+    FLT_MAX,
+    textLayout.put()));
+
+  DWRITE_TEXT_METRICS metrics {};
+  CheckHResult(textLayout->GetMetrics(&metrics));
+  return {
+    font, metrics.widthIncludingTrailingWhitespace, std::move(textLayout)};
+}
+
 Font::Metrics DirectWriteFontProvider::GetFontMetrics(const Font& font) const {
   using namespace font_detail;
   const auto props = font.as<DirectWriteFont>();
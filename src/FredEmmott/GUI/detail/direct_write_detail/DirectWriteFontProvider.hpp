@@ -19,6 +19,11 @@ struct DirectWriteFontProvider final : renderer_detail::FontMetricsProvider {
 
   float MeasureTextWidth(const Font& font, const std::string_view text)
     const override;
+  std::vector<float> MeasureTextOffsets(
+    const Font& font,
+    const std::string_view text) const override;
+  ShapedText ShapeText(const Font& font, const std::string_view text)
+    const override;
 
   Font::Metrics GetFontMetrics(const Font& font) const override;
 
@@ -0,0 +1,22 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "WidgetlessResultMixin.hpp"
+#include "widget_from_result.hpp"
+
+namespace FredEmmott::GUI::Immediate::immediate_detail {
+template <class... TMixins>
+struct PaintCachedResultMixin {};
+
+template <class... TMixins>
+  requires(!(std::same_as<TMixins, WidgetlessResultMixin> || ...))
+struct PaintCachedResultMixin<TMixins...> {
+  /// See `Widget::SetIsPaintCached()`
+  template <class Self>
+  decltype(auto) PaintCached(this Self&& self, const bool value = true) {
+    widget_from_result(self)->SetIsPaintCached(value);
+    return std::forward<Self>(self);
+  }
+};
+}// namespace FredEmmott::GUI::Immediate::immediate_detail
@@ -16,25 +16,21 @@ T* ChildlessWidget(const ID id, Args&&... args) {
   auto& frame = tStack.back();
 
   if constexpr (Config::Debug) {
-    if (std::ranges::contains(
-          frame.mNewSiblings, id.GetValue(), &Widget::GetID)) {
+    if (!frame.mNewSiblingIDs.Insert(
+          id.GetValue(), frame.mNewSiblings.size())) {
       throw std::logic_error("All siblings must have different IDs");
     }
   }
 
-  const auto pending
-    = std::ranges::find(frame.mPending, id.GetValue(), &Widget::GetID);
-
-  if (pending == frame.mPending.end()) {
+  if (const auto pending = TakePendingWidget(frame, id.GetValue())) {
+    frame.mNewSiblings.push_back(pending);
+  } else {
     const auto w = new T {
       tWindow,
       std::forward<Args>(args)...,
     };
     w->SetImmediateContext(GetCurrentParentNode(), id.GetValue());
     frame.mNewSiblings.push_back(w);
-  } else {
-    frame.mNewSiblings.push_back(*pending);
-    frame.mPending.erase(pending);
   }
 
   return static_cast<T*>(frame.mNewSiblings.back());
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: MIT
 #include "immediate_detail.hpp"
 
+#include <bit>
+
 namespace FredEmmott::GUI::Immediate::immediate_detail {
 
 thread_local std::vector<StackEntry> tStack;
@@ -10,4 +12,128 @@ thread_local bool tNeedAdditionalFrame {true};
 thread_local bool tResizeThisFrame {false};
 thread_local bool tResizeNextFrame {false};
 
+thread_local std::vector<std::vector<SiblingIndex::Slot>> SiblingIndex::tArena;
+
+SiblingIndex& SiblingIndex::operator=(SiblingIndex&& other) noexcept {
+  if (this != &other) {
+    this->Release();
+    mSlots = std::move(other.mSlots);
+    mSize = std::exchange(other.mSize, 0);
+  }
+  return *this;
+}
+
+SiblingIndex::~SiblingIndex() {
+  this->Release();
+}
+
+void SiblingIndex::Release() noexcept {
+  if (mSlots.capacity() == 0) {
+    return;
+  }
+  mSlots.clear();
+  mSize = 0;
+  try {
+    tArena.push_back(std::move(mSlots));
+  } catch (...) {
+    // Just a cache; if we can't store it, it's fine to free it
+  }
+  mSlots = {};
+}
+
+void SiblingIndex::Reserve(const std::size_t count) {
+  // Keep the load factor <= 0.5
+  const auto slotCount = std::bit_ceil(std::max<std::size_t>(count * 2, 16));
+  if (mSlots.size() >= slotCount) {
+    return;
+  }
+
+  auto old = std::move(mSlots);
+  if (tArena.empty()) {
+    mSlots = {};
+  } else {
+    mSlots = std::move(tArena.back());
+    tArena.pop_back();
+  }
+  mSlots.assign(slotCount, Slot {});
+  mSize = 0;
+  for (auto&& slot: old) {
+    if (slot.mPosition != Empty) {
+      this->Insert(slot.mID, slot.mPosition);
+    }
+  }
+  old.clear();
+  if (old.capacity()) {
+    tArena.push_back(std::move(old));
+  }
+}
+
+bool SiblingIndex::Insert(const id_type id, const std::size_t position) {
+  this->Reserve(mSize + 1);
+
+  // IDs are already hashes, so no need to hash again
+  const auto mask = mSlots.size() - 1;
+  for (auto i = static_cast<std::size_t>(id) & mask;; i = (i + 1) & mask) {
+    auto& slot = mSlots[i];
+    if (slot.mPosition == Empty) {
+      slot = {id, position};
+      ++mSize;
+      return true;
+    }
+    if (slot.mID == id) {
+      return false;
+    }
+  }
+}
+
+std::optional<std::size_t> SiblingIndex::Find(
+  const id_type id) const noexcept {
+  if (mSlots.empty()) {
+    return std::nullopt;
+  }
+  const auto mask = mSlots.size() - 1;
+  for (auto i = static_cast<std::size_t>(id) & mask;; i = (i + 1) & mask) {
+    const auto& slot = mSlots[i];
+    if (slot.mPosition == Empty) {
+      return std::nullopt;
+    }
+    if (slot.mID == id) {
+      return slot.mPosition;
+    }
+  }
+}
+
+Widget* TakePendingWidget(StackEntry& frame, const Widget::id_type id) {
+  auto& pending = frame.mPending;
+
+  // Fast path: same order as the previous frame
+  while (frame.mNextPending < pending.size() && !pending[frame.mNextPending]) {
+    ++frame.mNextPending;
+  }
+  if (
+    frame.mNextPending < pending.size()
+    && pending[frame.mNextPending]->GetID() == id) {
+    return std::exchange(pending[frame.mNextPending++], nullptr);
+  }
+
+  if (!frame.mPendingIndex.IsInitialized()) {
+    if (frame.mNextPending == pending.size()) {
+      // Everything's been reused
+      return nullptr;
+    }
+    frame.mPendingIndex.Reserve(pending.size() - frame.mNextPending);
+    for (std::size_t i = frame.mNextPending; i < pending.size(); ++i) {
+      if (pending[i]) {
+        frame.mPendingIndex.Insert(pending[i]->GetID(), i);
+      }
+    }
+  }
+
+  const auto position = frame.mPendingIndex.Find(id);
+  if (!position) {
+    return nullptr;
+  }
+  return std::exchange(pending[*position], nullptr);
+}
+
 }// namespace FredEmmott::GUI::Immediate::immediate_detail
@@ -6,6 +6,8 @@
 #include <FredEmmott/GUI/Widgets/Widget.hpp>
 #include <FredEmmott/GUI/Window.hpp>
 #include <format>
+#include <limits>
+#include <optional>
 
 #include "widget_detail.hpp"
 
@@ -14,12 +16,69 @@ namespace FredEmmott::GUI::Immediate::immediate_detail {
 using Widget = Widgets::Widget;
 using namespace Widgets::widget_detail;
 
+/** Open-addressed map from widget ID to a position in a sibling list.
+ *
+ * Slot storage is recycled via a per-thread free list, so building an index
+ * for every container, every frame, does not usually allocate.
+ */
+class SiblingIndex final {
+ public:
+  using id_type = Widget::id_type;
+
+  SiblingIndex() = default;
+  SiblingIndex(const SiblingIndex&) = delete;
+  SiblingIndex& operator=(const SiblingIndex&) = delete;
+  SiblingIndex(SiblingIndex&&) noexcept = default;
+  SiblingIndex& operator=(SiblingIndex&&) noexcept;
+  ~SiblingIndex();
+
+  [[nodiscard]]
+  bool IsInitialized() const noexcept {
+    return !mSlots.empty();
+  }
+
+  void Reserve(std::size_t count);
+  /// Returns false if the ID is already present
+  bool Insert(id_type id, std::size_t position);
+  [[nodiscard]]
+  std::optional<std::size_t> Find(id_type id) const noexcept;
+
+ private:
+  static constexpr std::size_t Empty = std::numeric_limits<std::size_t>::max();
+  struct Slot {
+    id_type mID {};
+    std::size_t mPosition {Empty};
+  };
+  std::vector<Slot> mSlots;
+  std::size_t mSize {};
+
+  // Storage from released indices; as these are only used by stack entries,
+  // this is bounded by the maximum nesting depth.
+  static thread_local std::vector<std::vector<Slot>> tArena;
+
+  void Release() noexcept;
+};
+
 // The current container is `mNewSiblings.back()` on the top-except-one entry
 struct StackEntry final {
+  // Last frame's children; reused widgets are replaced with `nullptr`
   std::vector<Widget*> mPending;
   std::vector<Widget*> mNewSiblings;
+  // Everything in `mPending` before this has already been reused
+  std::size_t mNextPending {};
+  // Only built if siblings aren't in the same order as last frame
+  SiblingIndex mPendingIndex;
+  // Only used in debug builds, to check for duplicate IDs
+  SiblingIndex mNewSiblingIDs;
 };
 
+/** Remove and return the widget with the given ID from `mPending`.
+ *
+ * Returns `nullptr` if there is no matching widget; O(1) if siblings are in
+ * the same order as last frame, amortized O(1) otherwise.
+ */
+Widget* TakePendingWidget(StackEntry&, Widget::id_type);
+
 extern thread_local std::vector<StackEntry> tStack;
 extern thread_local Window* tWindow;
 extern thread_local bool tNeedAdditionalFrame;
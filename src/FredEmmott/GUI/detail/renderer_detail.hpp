@@ -3,17 +3,42 @@
 #pragma once
 
 #include <FredEmmott/GUI/Font.hpp>
+#include <FredEmmott/GUI/ShapedText.hpp>
+#include <cstdint>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 namespace FredEmmott::GUI::renderer_detail {
 
 struct FontMetricsProvider {
   virtual ~FontMetricsProvider() = default;
   virtual float MeasureTextWidth(const Font&, std::string_view) const = 0;
+  /// See `Font::MeasureTextOffsets()`
+  virtual std::vector<float> MeasureTextOffsets(const Font&, std::string_view)
+    const = 0;
+  /// See `Font::ShapeText()`
+  virtual ShapedText ShapeText(const Font&, std::string_view) const = 0;
   virtual Font::Metrics GetFontMetrics(const Font&) const = 0;
 };
 
+/// The length of the UTF-8 sequence starting with `lead`
+[[nodiscard]]
+constexpr std::size_t GetUTF8SequenceLength(const char lead) noexcept {
+  const auto byte = static_cast<uint8_t>(lead);
+  if (byte < 0xc0) {
+    // ASCII, or an unexpected continuation byte
+    return 1;
+  }
+  if (byte < 0xe0) {
+    return 2;
+  }
+  if (byte < 0xf0) {
+    return 3;
+  }
+  return 4;
+}
+
 enum class RenderAPI {
   Skia,
   Direct2D,
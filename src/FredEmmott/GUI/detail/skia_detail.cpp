@@ -0,0 +1,106 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#include "skia_detail.hpp"
+
+#include <skia/core/SkFont.h>
+#include <skia/core/SkFontMetrics.h>
+#include <skia/core/SkTextBlob.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "font_detail.hpp"
+
+namespace FredEmmott::GUI::skia_detail {
+
+namespace {
+struct SkiaFontMetricsProvider final : renderer_detail::FontMetricsProvider {
+  ~SkiaFontMetricsProvider() override = default;
+
+  float MeasureTextWidth(const Font& font, const std::string_view text)
+    const override {
+    if (!font) {
+      return std::numeric_limits<float>::quiet_NaN();
+    }
+    const auto it = font.as<SkFont>();
+    return it.measureText(text.data(), text.size(), SkTextEncoding::kUTF8);
+  }
+
+  std::vector<float> MeasureTextOffsets(
+    const Font& font,
+    const std::string_view text) const override {
+    std::vector<float> ret(
+      text.size() + 1, std::numeric_limits<float>::quiet_NaN());
+    if (!font) {
+      return ret;
+    }
+    const auto it = font.as<SkFont>();
+    // `SkFont` does not shape text: each code point maps to exactly one
+    // glyph, and its advance does not depend on its neighbors. This lets us
+    // look up every glyph and advance in one pass.
+    //
+    // Skia rejects invalid UTF-8 entirely, giving no glyphs.
+    const auto glyphCount = std::max(
+      it.countText(text.data(), text.size(), SkTextEncoding::kUTF8), 0);
+    std::vector<SkGlyphID> glyphs(glyphCount);
+    it.textToGlyphs(
+      text.data(),
+      text.size(),
+      SkTextEncoding::kUTF8,
+      glyphs.data(),
+      glyphCount);
+    std::vector<SkScalar> advances(glyphCount);
+    it.getWidths(glyphs.data(), glyphCount, advances.data());
+
+    float x = 0;
+    std::size_t glyph = 0;
+    for (std::size_t i = 0; i < text.size();) {
+      ret[i] = x;
+      const auto length = std::min(
+        renderer_detail::GetUTF8SequenceLength(text[i]), text.size() - i);
+      if (glyph < advances.size()) {
+        x += advances[glyph++];
+      } else {
+        x += it.measureText(text.data() + i, length, SkTextEncoding::kUTF8);
+      }
+      i += length;
+    }
+    ret.back() = x;
+    return ret;
+  }
+
+  ShapedText ShapeText(const Font& font, const std::string_view text)
+    const override {
+    if (!font) {
+      return {};
+    }
+    const auto it = font.as<SkFont>();
+    return {
+      font,
+      it.measureText(text.data(), text.size(), SkTextEncoding::kUTF8),
+      SkTextBlob::MakeFromText(
+        text.data(), text.size(), it, SkTextEncoding::kUTF8),
+    };
+  }
+
+  Font::Metrics GetFontMetrics(const Font& font) const override {
+    using namespace font_detail;
+    const auto it = font.as<SkFont>();
+    SkFontMetrics pt {};
+    const auto lineSpacingPt = it.getMetrics(&pt);
+    return {
+      .mSize = it.getSize(),
+      .mLineSpacing = lineSpacingPt,
+      .mAscent = pt.fAscent,
+      .mDescent = pt.fDescent,
+    };
+  }
+};
+}// namespace
+
+std::unique_ptr<renderer_detail::FontMetricsProvider>
+CreateFontMetricsProvider() {
+  return std::make_unique<SkiaFontMetricsProvider>();
+}
+
+}// namespace FredEmmott::GUI::skia_detail
@@ -0,0 +1,15 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <memory>
+
+#include "renderer_detail.hpp"
+
+namespace FredEmmott::GUI::skia_detail {
+
+/// Font metrics for `Font`s backed by an `SkFont`; shared by Skia backends
+std::unique_ptr<renderer_detail::FontMetricsProvider>
+CreateFontMetricsProvider();
+
+}// namespace FredEmmott::GUI::skia_detail
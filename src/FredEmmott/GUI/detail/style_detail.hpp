@@ -151,6 +151,12 @@ enum class StylePropertyKey {
 #undef FUI_DECLARE_STYLE_PROPERTY
 };
 
+constexpr std::size_t StylePropertyCount = 0
+#define FUI_COUNT_STYLE_PROPERTY(...) +1
+  FUI_ENUM_STYLE_PROPERTIES(FUI_COUNT_STYLE_PROPERTY)
+#undef FUI_COUNT_STYLE_PROPERTY
+  ;
+
 template <StylePropertyKey K>
 struct property_type_t;
 template <StylePropertyKey K>
@@ -243,10 +243,7 @@ HRESULT TextStoreACP::SetText(
   if (acpStart > acpEnd)
     std::swap(acpStart, acpEnd);
 
-  const auto cur = mOwner->GetTextW();
   const std::wstring_view add {pchText, cch};
-  const auto newText
-    = std::format(L"{}{}{}", cur.substr(0, acpStart), add, cur.substr(acpEnd));
   const auto caret = acpStart + cch;
   if (pChange) {
     pChange->acpStart = acpStart;
@@ -254,7 +251,7 @@ HRESULT TextStoreACP::SetText(
     pChange->acpNewEnd = static_cast<LONG>(caret);
   }
   const auto guard = mOwner->GetAutomationActivityGuard();
-  mOwner->SetTextW(newText);
+  mOwner->ReplaceTextW(acpStart, acpEnd, add);
   mOwner->SetSelectionW(caret, caret);
   return S_OK;
 }
@@ -5,9 +5,11 @@
 
 #include <Yoga.h>
 
+#include <algorithm>
 #include <mutex>
 #include <optional>
 
+#include "Widgets/Widget.hpp"
 #include "assert.hpp"
 #include "detail/win32_detail/UIANode.hpp"
 
@@ -24,85 +26,228 @@ YGConfig* GetYogaConfig() {
   return sInstance.get();
 }
 
-float GetMinimumWidth(const YGNode* node, float hint) {
-  // We clone the node due to caching bugs with YGNodeCalculateLayout with
-  // varying sizes, and instead set the width property on the clone.
-  //
-  // This workaround is suggested here:
-  //
-  // https://github.com/facebook/yoga/issues/1003#issuecomment-642888983
-  const auto checkParents = ScopedYogaParentCheck(node);
-  const auto fixParents
-    = felly::scope_exit([node] { FixYogaChildren(const_cast<YGNode*>(node)); });
-  const unique_yoga_node_ptr owned {YGNodeClone(node)};
-  const auto yoga = owned.get();
-  YGNodeStyleSetOverflow(yoga, YGOverflowVisible);
-  YGNodeStyleSetFlexDirection(yoga, YGFlexDirectionRow);
-  YGNodeStyleSetWidth(yoga, hint);
-  YGNodeStyleSetHeight(yoga, YGUndefined);
-  YGNodeCalculateLayout(yoga, YGUndefined, YGUndefined, YGDirectionLTR);
+namespace {
 
-  if (!YGFloatIsUndefined(hint)) {
-    if (YGNodeLayoutGetHadOverflow(yoga)) {
-      return GetMinimumWidth(node, YGUndefined);
+// Percentages have no containing block to resolve against
+float GetPoints(const YGValue value) {
+  return (value.unit == YGUnitPoint) ? value.value : 0;
+}
+
+// `Style` sets individual edges, but respect the shorthands too
+float GetEdge(
+  const YGNode* node,
+  YGValue (*getter)(YGNodeConstRef, YGEdge),
+  const YGEdge edge) {
+  for (const auto it: {edge, YGEdgeHorizontal, YGEdgeAll}) {
+    if (const auto value = getter(node, it); value.unit != YGUnitUndefined) {
+      return GetPoints(value);
     }
-    YGNodeStyleSetWidth(yoga, hint - 2);
-    YGNodeCalculateLayout(yoga, YGUndefined, YGUndefined, YGDirectionLTR);
-    if (YGNodeLayoutGetHadOverflow(yoga)) {
-      return hint;
+  }
+  return 0;
+}
+
+float GetBorder(const YGNode* node, const YGEdge edge) {
+  for (const auto it: {edge, YGEdgeHorizontal, YGEdgeAll}) {
+    if (const auto value = YGNodeStyleGetBorder(node, it);
+        !YGFloatIsUndefined(value)) {
+      return value;
     }
   }
-  const auto contentMax = YGNodeLayoutGetWidth(yoga);
+  return 0;
+}
 
-  // SearchMin should be a reasonable value for a normal window, but we can have
-  // valid *tiny* windows, like tooltips. If their max size is smaller than
-  // SearchMin, we... can't grow it, and the max size is probably the ideal size
-  static constexpr auto SearchMin = 128;
-  if (contentMax <= SearchMin) {
-    return contentMax;
+float GetHorizontalMargin(const YGNode* node) {
+  return GetEdge(node, &YGNodeStyleGetMargin, YGEdgeLeft)
+    + GetEdge(node, &YGNodeStyleGetMargin, YGEdgeRight);
+}
+
+// Padding and border
+float GetHorizontalInset(const YGNode* node) {
+  return GetEdge(node, &YGNodeStyleGetPadding, YGEdgeLeft)
+    + GetEdge(node, &YGNodeStyleGetPadding, YGEdgeRight)
+    + GetBorder(node, YGEdgeLeft) + GetBorder(node, YGEdgeRight);
+}
+
+float GetColumnGap(const YGNode* node) {
+  for (const auto it: {YGGutterColumn, YGGutterAll}) {
+    if (const auto value = YGNodeStyleGetGap(node, it);
+        !YGFloatIsUndefined(value)) {
+      return value;
+    }
   }
-  return GetClampedMinimumWidth(node, 128, contentMax);
+  return 0;
 }
 
-float GetClampedMinimumWidth(
-  const YGNode* node,
-  float min,
-  float max,
-  const ClampedMinimumWidthHint hint) {
-  const auto checkParents = ScopedYogaParentCheck(node);
-  const auto fixParents
-    = felly::scope_exit([node] { FixYogaChildren(const_cast<YGNode*>(node)); });
-  const unique_yoga_node_ptr owned {YGNodeClone(node)};
-  const auto yoga = owned.get();
+float ToBorderBox(const YGNode* node, const float width) {
+  if (YGNodeStyleGetBoxSizing(node) == YGBoxSizingContentBox) {
+    return width + GetHorizontalInset(node);
+  }
+  return width;
+}
 
-  if (hint == ClampedMinimumWidthHint::MinimumIsLikely) {
-    YGNodeStyleSetWidth(yoga, min);
-    YGNodeCalculateLayout(yoga, YGUndefined, YGUndefined, YGDirectionLTR);
-    if (!YGNodeLayoutGetHadOverflow(yoga)) {
-      return min;
+IntrinsicWidths ApplyMinMax(const YGNode* node, IntrinsicWidths widths) {
+  const auto max = YGNodeStyleGetMaxWidth(node);
+  const auto min = YGNodeStyleGetMinWidth(node);
+  for (auto&& it: {&widths.mMinContent, &widths.mMaxContent}) {
+    if (max.unit == YGUnitPoint) {
+      *it = std::min(*it, ToBorderBox(node, max.value));
+    }
+    if (min.unit == YGUnitPoint) {
+      *it = std::max(*it, ToBorderBox(node, min.value));
     }
   }
+  return widths;
+}
+
+/** Width that a node with a measure function picks given `available` width.
+ *
+ * The measure function is invoked via yoga on a clone, so that the usual
+ * padding, border, and min/max constraints apply; the clone is laid out in
+ * a container so that it can be measured with `YGMeasureModeAtMost`.
+ */
+float MeasureLeafWidth(const YGNode* node, const float available) {
+  const unique_yoga_node_ptr ownedContainer {
+    YGNodeNewWithConfig(GetYogaConfig())};
+  const unique_yoga_node_ptr ownedLeaf {YGNodeClone(node)};
+  const auto container = ownedContainer.get();
+  const auto leaf = ownedLeaf.get();
 
-  while ((max - min) > 1) {
-    const auto mid = std::ceil((min + max) / 2);
-    YGNodeStyleSetWidth(yoga, mid);
-    YGNodeCalculateLayout(yoga, YGUndefined, YGUndefined, YGDirectionLTR);
-    if (YGNodeLayoutGetHadOverflow(yoga)) {
-      if (mid - min < 1) {
-        break;
-      }
-      min = mid;
+  // Some measure functions find their widget via the parent node
+  if (const auto parent = YGNodeGetParent(const_cast<YGNode*>(node))) {
+    YGNodeSetContext(container, YGNodeGetContext(parent));
+  }
+  YGNodeStyleSetFlexDirection(container, YGFlexDirectionColumn);
+  YGNodeStyleSetAlignItems(container, YGAlignFlexStart);
+  YGNodeStyleSetWidth(container, available);
+  YGNodeStyleSetAlignSelf(leaf, YGAlignFlexStart);
+  YGNodeInsertChild(container, leaf, 0);
+  YGNodeCalculateLayout(container, YGUndefined, YGUndefined, YGDirectionLTR);
+  const auto ret = YGNodeLayoutGetWidth(leaf);
+  YGNodeRemoveChild(container, leaf);
+  return ret;
+}
+
+void ForEachInFlowChild(const YGNode* node, auto&& f) {
+  const auto childCount = YGNodeGetChildCount(node);
+  for (std::size_t i = 0; i < childCount; ++i) {
+    const auto child = YGNodeGetChild(const_cast<YGNode*>(node), i);
+    if (YGNodeStyleGetPositionType(child) == YGPositionTypeAbsolute) {
+      continue;
+    }
+    switch (YGNodeStyleGetDisplay(child)) {
+      case YGDisplayNone:
+        continue;
+      case YGDisplayContents:
+        ForEachInFlowChild(child, f);
+        continue;
+      default:
+        f(child);
+    }
+  }
+}
+
+/// Intrinsic widths from the node's children, padding, and border
+IntrinsicWidths GetContentWidths(const YGNode* node, const bool isRow) {
+  const bool wraps = YGNodeStyleGetFlexWrap(node) != YGWrapNoWrap;
+
+  IntrinsicWidths ret {};
+  std::size_t count = 0;
+  ForEachInFlowChild(node, [&](const YGNode* child) {
+    auto [childMin, childMax] = GetIntrinsicWidths(child);
+    // Along the main axis, items can only shrink if they have a flex-shrink
+    if (isRow && YGNodeStyleGetFlexShrink(child) == 0) {
+      childMin = childMax;
+    }
+    const auto margin = GetHorizontalMargin(child);
+    childMin += margin;
+    childMax += margin;
+    ++count;
+
+    if (!isRow) {
+      ret.mMinContent = std::max(ret.mMinContent, childMin);
+      ret.mMaxContent = std::max(ret.mMaxContent, childMax);
+      return;
+    }
+    ret.mMaxContent += childMax;
+    if (wraps) {
+      ret.mMinContent = std::max(ret.mMinContent, childMin);
     } else {
-      if (max - mid < 1) {
-        break;
-      }
-      max = mid;
+      ret.mMinContent += childMin;
     }
+  });
+
+  if (isRow && count > 1) {
+    const auto gaps = GetColumnGap(node) * static_cast<float>(count - 1);
+    ret.mMaxContent += gaps;
+    if (!wraps) {
+      ret.mMinContent += gaps;
+    }
+  }
+
+  const auto inset = GetHorizontalInset(node);
+  ret.mMinContent += inset;
+  ret.mMaxContent += inset;
+  return ApplyMinMax(node, ret);
+}
+
+IntrinsicWidths CalculateIntrinsicWidths(const YGNode* node) {
+  if (YGNodeStyleGetDisplay(node) == YGDisplayNone) {
+    return {};
+  }
+  if (const auto width = YGNodeStyleGetWidth(node);
+      width.unit == YGUnitPoint) {
+    const auto borderBox = ToBorderBox(node, width.value);
+    return ApplyMinMax(node, {borderBox, borderBox});
+  }
+  if (YGNodeHasMeasureFunc(node)) {
+    return {
+      MeasureLeafWidth(node, 0),
+      MeasureLeafWidth(node, YGUndefined),
+    };
+  }
+  const auto direction = YGNodeStyleGetFlexDirection(node);
+  return GetContentWidths(
+    node,
+    direction == YGFlexDirectionRow || direction == YGFlexDirectionRowReverse);
+}
+
+}// namespace
+
+IntrinsicWidths GetIntrinsicWidths(const YGNode* node) {
+  const auto widget = Widgets::Widget::FromYogaNode(node);
+  if (widget && widget->mIntrinsicWidths) {
+    return *widget->mIntrinsicWidths;
   }
-  return max;
+  const auto ret = CalculateIntrinsicWidths(node);
+  // Yoga only calls the dirtied callback when a clean node becomes dirty, so
+  // we can only rely on it to invalidate results cached while clean
+  if (widget && !YGNodeIsDirty(node)) {
+    widget->mIntrinsicWidths = ret;
+  }
+  return ret;
 }
+
 float GetMinimumWidth(const YGNode* node) {
-  return GetMinimumWidth(node, YGUndefined);
+  // As a row, so that the content's ability to shrink is along the main axis
+  const auto [min, max] = GetContentWidths(node, /* isRow = */ true);
+
+  // This should be a reasonable minimum for a normal window, but we can have
+  // valid *tiny* windows, like tooltips. If their content is narrower than
+  // this, the maximum size is probably the ideal size.
+  static constexpr float TinyWidth = 128;
+  if (max <= TinyWidth) {
+    return max;
+  }
+  return std::clamp(min, TinyWidth, max);
+}
+
+float GetClampedMinimumWidth(
+  const YGNode* node,
+  const float min,
+  const float max) {
+  FUI_ASSERT(min <= max);
+  return std::clamp(
+    GetContentWidths(node, /* isRow = */ true).mMinContent, min, max);
 }
 
 float GetIdealHeight(const YGNode* node, float width) {
@@ -20,18 +20,28 @@ using unique_yoga_node_ptr = felly::unique_ptr<YGNode, &YGNodeFree>;
 using unique_yoga_config_ptr = felly::unique_ptr<YGConfig, &YGConfigFree>;
 
 YGConfig* GetYogaConfig();
-float GetMinimumWidth(const YGNode* node);
-float GetMinimumWidth(const YGNode* node, float hint);
-enum class ClampedMinimumWidthHint {
-  None,
-  MinimumIsLikely,
+/** Border-box widths of a node when sized to its content.
+ *
+ * `mMinContent` is the narrowest width that the content can shrink or wrap
+ * to without overflowing; `mMaxContent` is the width without any shrinking
+ * or wrapping.
+ */
+struct IntrinsicWidths {
+  float mMinContent {};
+  float mMaxContent {};
 };
 
-float GetClampedMinimumWidth(
-  const YGNode* node,
-  float min,
-  float max,
-  ClampedMinimumWidthHint hint = ClampedMinimumWidthHint::None);
+/** Intrinsic widths, from a single pass over the subtree.
+ *
+ * Results are cached per widget, and invalidated when Yoga marks the
+ * widget's node as dirty.
+ */
+[[nodiscard]]
+IntrinsicWidths GetIntrinsicWidths(const YGNode* node);
+
+/// Minimum width of the node's content, laid out as a row
+float GetMinimumWidth(const YGNode* node);
+float GetClampedMinimumWidth(const YGNode* node, float min, float max);
 
 float GetIdealHeight(const YGNode* node, float width);
 Size GetMinimumWidthAndIdealHeight(const YGNode* node);
@@ -0,0 +1,238 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FredEmmott/type_traits/concepts.hpp>
+#include <array>
+#include <bit>
+#include <boost/container/small_vector.hpp>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace FredEmmott::utility {
+
+/** A map keyed by a dense enum, stored as a sorted flat vector plus a
+ * presence bitset.
+ *
+ * - `contains()` is a bit test
+ * - lookup is a popcount, not a hash or a search
+ * - values are contiguous, and stored inline up to `InlineCapacity`
+ * - `merge()` is a single pass over both maps, without temporary storage
+ *
+ * This primarily exists for the `GUI::Style` class; `K` must have values in
+ * the range `[0, KeyCount)`.
+ */
+template <
+  concepts::scoped_enum K,
+  std::size_t KeyCount,
+  class V,
+  std::size_t InlineCapacity>
+class flat_enum_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using size_type = std::size_t;
+  using storage_type
+    = boost::container::small_vector<value_type, InlineCapacity>;
+  using iterator = typename storage_type::iterator;
+  using const_iterator = typename storage_type::const_iterator;
+
+  constexpr flat_enum_map() = default;
+  constexpr flat_enum_map(const flat_enum_map&) = default;
+  constexpr flat_enum_map(flat_enum_map&&) noexcept = default;
+  constexpr flat_enum_map& operator=(const flat_enum_map&) = default;
+  constexpr flat_enum_map& operator=(flat_enum_map&&) noexcept = default;
+
+  auto begin() noexcept {
+    return mValues.begin();
+  }
+
+  auto end() noexcept {
+    return mValues.end();
+  }
+
+  auto begin() const noexcept {
+    return mValues.begin();
+  }
+
+  auto end() const noexcept {
+    return mValues.end();
+  }
+
+  [[nodiscard]]
+  size_type size() const noexcept {
+    return mValues.size();
+  }
+
+  [[nodiscard]]
+  bool empty() const noexcept {
+    return mValues.empty();
+  }
+
+  [[nodiscard]]
+  constexpr bool contains(const K key) const noexcept {
+    const auto i = ToIndex(key);
+    return (mPresent[i / WordBits] & (uint64_t {1} << (i % WordBits))) != 0;
+  }
+
+  bool operator==(const flat_enum_map& other) const noexcept {
+    return mPresent == other.mPresent && mValues == other.mValues;
+  }
+
+  const V& at(const K key) const {
+    if (!contains(key)) {
+      throw std::out_of_range("Key is not present in const flat_enum_map");
+    }
+    return mValues[Rank(key)].second;
+  }
+
+  V& at(const K key) {
+    if (!contains(key)) {
+      throw std::out_of_range("Key is not present in flat_enum_map");
+    }
+    return mValues[Rank(key)].second;
+  }
+
+  const V& operator[](const K key) const {
+    return at(key);
+  }
+
+  V& operator[](const K key) {
+    return emplace(key).first->second;
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(const K key, Args&&... args) {
+    const auto rank = Rank(key);
+    if (contains(key)) {
+      return {mValues.begin() + rank, false};
+    }
+    SetPresent(key);
+    const auto it = mValues.emplace(
+      mValues.begin() + rank,
+      std::piecewise_construct,
+      std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+    return {it, true};
+  }
+
+  template <class U>
+  std::pair<iterator, bool> insert_or_assign(const K key, U&& value) {
+    if (contains(key)) {
+      auto it = mValues.begin() + Rank(key);
+      it->second = std::forward<U>(value);
+      return {it, false};
+    }
+    return emplace(key, std::forward<U>(value));
+  }
+
+  void erase(const K key) {
+    if (!contains(key)) {
+      return;
+    }
+    mValues.erase(mValues.begin() + Rank(key));
+    const auto i = ToIndex(key);
+    mPresent[i / WordBits] &= ~(uint64_t {1} << (i % WordBits));
+  }
+
+  void clear() noexcept {
+    mValues.clear();
+    mPresent = {};
+  }
+
+  /** Merge `other` into this map.
+   *
+   * For keys that are present in both maps,
+   * `mergeValues(K key, V& ours, const V& theirs)` is called; other values
+   * from `other` are copied.
+   *
+   * Existing values are moved at most once, and storage grows at most once.
+   */
+  template <std::invocable<K, V&, const V&> F>
+  void merge(const flat_enum_map& other, F&& mergeValues) {
+    std::size_t added = 0;
+    for (std::size_t i = 0; i < WordCount; ++i) {
+      added += std::popcount(other.mPresent[i] & ~mPresent[i]);
+    }
+
+    if (added == 0) {
+      for (auto&& [key, value]: other.mValues) {
+        std::invoke(mergeValues, key, mValues[Rank(key)].second, value);
+      }
+      return;
+    }
+
+    for (std::size_t i = 0; i < WordCount; ++i) {
+      mPresent[i] |= other.mPresent[i];
+    }
+
+    // Merge from the back so that we can work in-place
+    auto ours = static_cast<std::ptrdiff_t>(mValues.size()) - 1;
+    auto theirs = static_cast<std::ptrdiff_t>(other.mValues.size()) - 1;
+    mValues.resize(mValues.size() + added);
+    auto out = static_cast<std::ptrdiff_t>(mValues.size()) - 1;
+
+    // Once `out == ours`, every new key has been placed; the rest of `ours`
+    // is already in its final position.
+    while (theirs >= 0 && out != ours) {
+      const auto& source = other.mValues[theirs];
+      if (ours >= 0 && mValues[ours].first > source.first) {
+        mValues[out--] = std::move(mValues[ours--]);
+        continue;
+      }
+      if (ours >= 0 && mValues[ours].first == source.first) {
+        std::invoke(
+          mergeValues, source.first, mValues[ours].second, source.second);
+        mValues[out--] = std::move(mValues[ours--]);
+        --theirs;
+        continue;
+      }
+      mValues[out--] = source;
+      --theirs;
+    }
+
+    while (theirs >= 0) {
+      const auto& source = other.mValues[theirs--];
+      while (mValues[ours].first > source.first) {
+        --ours;
+      }
+      std::invoke(
+        mergeValues, source.first, mValues[ours].second, source.second);
+    }
+  }
+
+ private:
+  static constexpr std::size_t WordBits = 64;
+  static constexpr std::size_t WordCount = (KeyCount + WordBits - 1) / WordBits;
+
+  std::array<uint64_t, WordCount> mPresent {};
+  storage_type mValues;
+
+  static constexpr std::size_t ToIndex(const K key) noexcept {
+    return static_cast<std::size_t>(std::to_underlying(key));
+  }
+
+  constexpr void SetPresent(const K key) noexcept {
+    const auto i = ToIndex(key);
+    mPresent[i / WordBits] |= (uint64_t {1} << (i % WordBits));
+  }
+
+  /// The index of `key` in `mValues`, or where it would be inserted
+  [[nodiscard]]
+  constexpr std::size_t Rank(const K key) const noexcept {
+    const auto i = ToIndex(key);
+    const auto word = i / WordBits;
+    std::size_t ret = 0;
+    for (std::size_t j = 0; j < word; ++j) {
+      ret += std::popcount(mPresent[j]);
+    }
+    const auto mask = (uint64_t {1} << (i % WordBits)) - 1;
+    return ret + std::popcount(mPresent[word] & mask);
+  }
+};
+
+}// namespace FredEmmott::utility
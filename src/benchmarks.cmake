@@ -0,0 +1,38 @@
+find_package(benchmark CONFIG REQUIRED)
+
+add_executable(
+  fredemmott-gui-benchmarks
+  benchmarks/Style.cpp
+)
+target_link_libraries(
+  fredemmott-gui-benchmarks
+  PRIVATE
+  fredemmott-gui
+  benchmark::benchmark
+  benchmark::benchmark_main
+)
+
+# These need `OffscreenWindow`, which renders with Skia
+if (ENABLE_SKIA)
+  target_sources(
+    fredemmott-gui-benchmarks
+    PRIVATE
+    benchmarks/common.hpp
+    benchmarks/Immediate.cpp
+    benchmarks/SkiaRenderer.cpp
+    benchmarks/Widget.cpp
+  )
+endif ()
+
+# Machine-readable results, e.g. for comparing against a baseline in CI with
+# Google Benchmark's `tools/compare.py`
+set(BENCHMARKS_JSON "${CMAKE_CURRENT_BINARY_DIR}/benchmarks.json")
+add_custom_target(
+  run-benchmarks
+  COMMAND
+  fredemmott-gui-benchmarks
+  "--benchmark_out=${BENCHMARKS_JSON}"
+  --benchmark_out_format=json
+  BYPRODUCTS "${BENCHMARKS_JSON}"
+  USES_TERMINAL
+)
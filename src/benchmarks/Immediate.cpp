@@ -0,0 +1,154 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <benchmark/benchmark.h>
+
+#include <FredEmmott/GUI.hpp>
+#include <FredEmmott/GUI/FrameProfiler.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+
+using namespace FredEmmott::GUI;
+using FredEmmott::GUI::benchmarks::GetWindow;
+namespace fuii = FredEmmott::GUI::Immediate;
+
+namespace {
+
+enum class IDOrder {
+  // The same widgets in the same order each frame
+  Stable,
+  // The same widgets, in a different order each frame
+  Shuffled,
+  // Every other frame has 10% more widgets at the end
+  Appended,
+};
+
+constexpr std::string_view ItemText {"Item"};
+// Alternating the text makes every label need relayout and repaint
+constexpr std::array<std::string_view, 2> AlternatingItemTexts {
+  "Item A",
+  "Item B",
+};
+
+/// Two frames worth of IDs; the benchmarks alternate between them
+std::array<std::vector<uint64_t>, 2> MakeIDs(
+  const IDOrder order,
+  const std::size_t count) {
+  std::vector<uint64_t> ids(count);
+  std::ranges::iota(ids, uint64_t {1});
+
+  switch (order) {
+    case IDOrder::Stable:
+      return {ids, ids};
+    case IDOrder::Shuffled: {
+      // Fixed seed, for comparable results between runs
+      std::mt19937_64 random {count};
+      auto shuffled = ids;
+      std::ranges::shuffle(shuffled, random);
+      return {ids, shuffled};
+    }
+    case IDOrder::Appended: {
+      auto appended = ids;
+      for (std::size_t i = 0; i < count / 10; ++i) {
+        appended.push_back(count + i + 1);
+      }
+      return {ids, appended};
+    }
+  }
+  std::unreachable();
+}
+
+[[nodiscard]]
+bool RunFrame(
+  OffscreenWindow* window,
+  const std::span<const uint64_t> ids,
+  const std::string_view text = ItemText) {
+  if (!window->BeginFrame()) {
+    return false;
+  }
+  {
+    const auto panel = fuii::BeginVStackPanel(fuii::ID {"Root"}).Scoped();
+    for (const auto id: ids) {
+      fuii::Label(text, fuii::ID {id});
+    }
+  }
+  window->EndFrame();
+  return true;
+}
+
+std::chrono::duration<double> GetReconcileTime(const FrameProfile& frame) {
+  const auto& userCallback
+    = frame.mPhases[std::to_underlying(FramePhase::UserCallback)];
+  const auto& reconcile
+    = frame.mPhases[std::to_underlying(FramePhase::Reconcile)];
+  return userCallback.mDuration + reconcile.mDuration;
+}
+
+}// namespace
+
+/** Time to build and reconcile the widget tree, excluding layout and paint.
+ *
+ * This uses the window's `FrameProfiler` as the immediate-mode API can only
+ * be used within a complete frame.
+ */
+static void BM_Immediate_Reconcile(
+  benchmark::State& state,
+  const IDOrder order) {
+  const auto window = GetWindow();
+  const auto ids = MakeIDs(order, static_cast<std::size_t>(state.range(0)));
+  const auto profiler = window->GetProfiler();
+  profiler->SetIsEnabled(true);
+
+  std::size_t i = 0;
+  for (auto _: state) {
+    if (!RunFrame(window, ids[i++ % ids.size()])) {
+      state.SkipWithError("Window exited");
+      break;
+    }
+    state.SetIterationTime(
+      GetReconcileTime(*profiler->GetLatestFrame()).count());
+  }
+
+  profiler->SetIsEnabled(false);
+  profiler->Clear();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_Immediate_Reconcile, stable, IDOrder::Stable)
+  ->UseManualTime()
+  ->Arg(100)
+  ->Arg(1'000);
+BENCHMARK_CAPTURE(BM_Immediate_Reconcile, shuffled, IDOrder::Shuffled)
+  ->UseManualTime()
+  ->Arg(100)
+  ->Arg(1'000);
+BENCHMARK_CAPTURE(BM_Immediate_Reconcile, appended, IDOrder::Appended)
+  ->UseManualTime()
+  ->Arg(100)
+  ->Arg(1'000);
+
+/// A complete frame: reconciliation, layout, and painting to the raster surface
+static void BM_Immediate_Frame(benchmark::State& state) {
+  const auto window = GetWindow();
+  const auto ids
+    = MakeIDs(IDOrder::Stable, static_cast<std::size_t>(state.range(0)));
+  std::size_t i = 0;
+  for (auto _: state) {
+    const auto text
+      = AlternatingItemTexts[i++ % AlternatingItemTexts.size()];
+    if (!RunFrame(window, ids.front(), text)) {
+      state.SkipWithError("Window exited");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Immediate_Frame)->Arg(100)->Arg(1'000);
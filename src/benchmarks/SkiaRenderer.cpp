@@ -0,0 +1,119 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <benchmark/benchmark.h>
+#include <skia/core/SkImageInfo.h>
+#include <skia/core/SkSurface.h>
+
+#include <FredEmmott/GUI/Color.hpp>
+#include <FredEmmott/GUI/SkiaRenderer.hpp>
+#include <FredEmmott/GUI/SystemFont.hpp>
+#include <memory>
+#include <tuple>
+
+#include "common.hpp"
+
+using namespace FredEmmott::GUI;
+using FredEmmott::GUI::benchmarks::GetWindow;
+
+namespace {
+
+struct RasterCompletionFlag final : GPUCompletionFlag {
+  ~RasterCompletionFlag() override = default;
+
+  bool IsComplete() const override {
+    return true;
+  }
+
+  void Wait() const override {}
+};
+
+constexpr Size CanvasSize {1280, 720};
+constexpr Size CellSize {64, 32};
+
+class RasterTarget {
+ public:
+  RasterTarget()
+    : mSurface(SkSurfaces::Raster(SkImageInfo::Make(
+        static_cast<int>(CanvasSize.mWidth),
+        static_cast<int>(CanvasSize.mHeight),
+        kBGRA_8888_SkColorType,
+        kPremul_SkAlphaType))) {
+    // The window sets the Skia render API and font metrics provider
+    std::ignore = GetWindow();
+  }
+
+  [[nodiscard]]
+  SkiaRenderer CreateRenderer() const {
+    return SkiaRenderer {
+      SkiaRenderer::NativeDevice {},
+      mSurface->getCanvas(),
+      std::make_shared<RasterCompletionFlag>(),
+    };
+  }
+
+ private:
+  sk_sp<SkSurface> mSurface;
+};
+
+/// Call `f(rect)` for each cell in a grid covering the canvas
+void ForEachCell(auto&& f) {
+  for (float y = 0; y + CellSize.mHeight <= CanvasSize.mHeight;
+       y += CellSize.mHeight) {
+    for (float x = 0; x + CellSize.mWidth <= CanvasSize.mWidth;
+         x += CellSize.mWidth) {
+      f(Rect {Point {x, y}, CellSize});
+    }
+  }
+}
+
+constexpr std::size_t CellCount
+  = static_cast<std::size_t>(CanvasSize.mWidth / CellSize.mWidth)
+  * static_cast<std::size_t>(CanvasSize.mHeight / CellSize.mHeight);
+
+}// namespace
+
+static void BM_SkiaRenderer_FillRect(benchmark::State& state) {
+  const RasterTarget target;
+  for (auto _: state) {
+    auto renderer = target.CreateRenderer();
+    renderer.Clear(Colors::White);
+    ForEachCell([&](const Rect& rect) {
+      renderer.FillRect(Colors::Black, rect);
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * CellCount);
+}
+BENCHMARK(BM_SkiaRenderer_FillRect);
+
+static void BM_SkiaRenderer_FillRoundedRect(benchmark::State& state) {
+  const RasterTarget target;
+  for (auto _: state) {
+    auto renderer = target.CreateRenderer();
+    renderer.Clear(Colors::White);
+    ForEachCell([&](const Rect& rect) {
+      renderer.FillRoundedRect(Colors::Black, rect, CornerRadius {4});
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * CellCount);
+}
+BENCHMARK(BM_SkiaRenderer_FillRoundedRect);
+
+static void BM_SkiaRenderer_DrawText(benchmark::State& state) {
+  const RasterTarget target;
+  const auto font = SystemFont::Resolve(SystemFont::Body);
+  for (auto _: state) {
+    auto renderer = target.CreateRenderer();
+    renderer.Clear(Colors::White);
+    ForEachCell([&](const Rect& rect) {
+      renderer.DrawText(
+        Colors::Black,
+        rect,
+        font,
+        "Item",
+        Point {rect.GetLeft(), rect.GetBottom()});
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * CellCount);
+}
+BENCHMARK(BM_SkiaRenderer_DrawText);
@@ -0,0 +1,148 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <benchmark/benchmark.h>
+
+#include <FredEmmott/GUI/Style.hpp>
+#include <FredEmmott/utility/unordered_map.hpp>
+
+using namespace FredEmmott::GUI;
+
+namespace {
+
+// A typical class style; the properties match `MakeLegacyBaseStorage()`, so
+// the `BM_Style_*` and `BM_LegacyStorage_*` results are comparable
+Style MakeBaseStyle() {
+  return Style()
+    .FlexGrow(1)
+    .Gap(8)
+    .Height(32)
+    .MinWidth(120)
+    .Opacity(1)
+    .Padding(4);
+}
+
+Style MakeOverrideStyle() {
+  return Style().FlexGrow(0).Height(40).MarginLeft(2).Opacity(0.5f).Width(200);
+}
+
+// Storage as it was before Style used `utility::flat_enum_map`, for
+// comparison; this only covers property storage, not selectors
+using LegacyStorage = FredEmmott::utility::unordered_map<
+  StylePropertyKey,
+  FredEmmott::utility::drop_last_t<
+    std::variant,
+#define DECLARE_STORAGE(TYPE, NAME) StyleProperty<TYPE>,
+    FUI_ENUM_STYLE_PROPERTY_TYPES(DECLARE_STORAGE)
+#undef DECLARE_STORAGE
+      void>>;
+
+LegacyStorage MakeLegacyStorage(std::initializer_list<
+                                std::tuple<StylePropertyKey, float>> values) {
+  LegacyStorage ret;
+  for (auto&& [key, value]: values) {
+    ret.emplace(key, StyleProperty<float> {value});
+  }
+  return ret;
+}
+
+LegacyStorage MakeLegacyBaseStorage() {
+  using enum StylePropertyKey;
+  return MakeLegacyStorage({
+    {FlexGrow, 1},
+    {Gap, 8},
+    {Height, 32},
+    {MinWidth, 120},
+    {Opacity, 1},
+    {PaddingLeft, 4},
+    {PaddingTop, 4},
+    {PaddingRight, 4},
+    {PaddingBottom, 4},
+  });
+}
+
+LegacyStorage MakeLegacyOverrideStorage() {
+  using enum StylePropertyKey;
+  return MakeLegacyStorage({
+    {FlexGrow, 0},
+    {Height, 40},
+    {MarginLeft, 2},
+    {Opacity, 0.5f},
+    {Width, 200},
+  });
+}
+
+void LegacyMerge(LegacyStorage& lhs, const LegacyStorage& rhs) {
+  for (auto&& [key, value]: rhs) {
+    if (!lhs.contains(key)) {
+      lhs.emplace(key, value);
+      continue;
+    }
+    style_detail::VisitStyleProperty(
+      key, [](auto& dest, const auto& src) { dest += src; }, lhs[key], value);
+  }
+}
+
+}// namespace
+
+static void BM_Style_Copy(benchmark::State& state) {
+  const auto style = MakeBaseStyle();
+  for (auto _: state) {
+    Style copy {style};
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_Style_Copy);
+
+static void BM_Style_Merge(benchmark::State& state) {
+  const auto base = MakeBaseStyle();
+  const auto override = MakeOverrideStyle();
+  for (auto _: state) {
+    auto merged = base + override;
+    benchmark::DoNotOptimize(merged);
+  }
+}
+BENCHMARK(BM_Style_Merge);
+
+static void BM_Style_MergeInPlace(benchmark::State& state) {
+  const auto base = MakeBaseStyle();
+  const auto override = MakeOverrideStyle();
+  // Includes a copy, as `PauseTiming()` costs more than the merge; compare
+  // against `BM_Style_Copy`
+  for (auto _: state) {
+    auto merged = base;
+    merged += override;
+    benchmark::DoNotOptimize(merged);
+  }
+}
+BENCHMARK(BM_Style_MergeInPlace);
+
+static void BM_Style_InheritableValues(benchmark::State& state) {
+  const auto style = MakeBaseStyle()
+    + Style().Cursor(Cursor::Pointer).TextAlign(TextAlign::Left);
+  for (auto _: state) {
+    auto inheritable = style.InheritableValues();
+    benchmark::DoNotOptimize(inheritable);
+  }
+}
+BENCHMARK(BM_Style_InheritableValues);
+
+static void BM_LegacyStorage_Copy(benchmark::State& state) {
+  const auto storage = MakeLegacyBaseStorage();
+  for (auto _: state) {
+    LegacyStorage copy {storage};
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_LegacyStorage_Copy);
+
+static void BM_LegacyStorage_Merge(benchmark::State& state) {
+  const auto base = MakeLegacyBaseStorage();
+  const auto override = MakeLegacyOverrideStorage();
+  for (auto _: state) {
+    auto merged = base;
+    LegacyMerge(merged, override);
+    benchmark::DoNotOptimize(merged);
+  }
+}
+BENCHMARK(BM_LegacyStorage_Merge);
@@ -0,0 +1,166 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <benchmark/benchmark.h>
+
+#include <Yoga.h>
+
+#include <FredEmmott/GUI/SystemFont.hpp>
+#include <FredEmmott/GUI/Widgets/TextBlock.hpp>
+#include <FredEmmott/GUI/Widgets/Widget.hpp>
+#include <FredEmmott/GUI/yoga.hpp>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common.hpp"
+
+using namespace FredEmmott::GUI;
+using FredEmmott::GUI::benchmarks::GetWindow;
+using Widgets::Widget;
+
+namespace {
+
+constexpr LiteralStyleClass BenchmarkStyleClass {"Benchmark/Widget"};
+
+auto& BenchmarkStyles() {
+  static const ImmutableStyle ret {
+    Style()
+      .FlexDirection(FlexDirection::Column)
+      .MinWidth(8)
+      .Padding(2)
+      .And(PseudoClasses::Hover, Style().Opacity(0.8f)),
+  };
+  return ret;
+}
+
+/** Create a tree of `count` widgets, in breadth-first order.
+ *
+ * A `fanout` of 1 gives a single chain of widgets; a fanout of `count` or
+ * more gives a root with every other widget as a direct child.
+ */
+std::unique_ptr<Widget> MakeTree(
+  const std::size_t count,
+  const std::size_t fanout) {
+  std::vector<Widget*> widgets;
+  widgets.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    widgets.push_back(
+      new Widget(GetWindow(), BenchmarkStyleClass, BenchmarkStyles()));
+  }
+  for (std::size_t parent = 0; (parent * fanout) + 1 < count; ++parent) {
+    const auto first = (parent * fanout) + 1;
+    const auto last = std::min(first + fanout, count);
+    widgets.at(parent)->SetStructuralChildren(
+      std::vector<Widget*> {widgets.begin() + first, widgets.begin() + last});
+  }
+  return std::unique_ptr<Widget> {widgets.front()};
+}
+
+std::unique_ptr<Widget> MakeTree(const benchmark::State& state) {
+  return MakeTree(
+    static_cast<std::size_t>(state.range(0)),
+    static_cast<std::size_t>(state.range(1)));
+}
+
+// Changing an inherited property means every widget must be restyled
+const std::array<Style, 2> InvalidatingStyles {
+  Style().TextAlign(TextAlign::Left),
+  Style().TextAlign(TextAlign::Right),
+};
+
+std::string MakeText(const std::size_t length, const std::string_view word) {
+  std::string ret;
+  ret.reserve(length + word.size());
+  while (ret.size() < length) {
+    ret += word;
+  }
+  ret.resize(length);
+  return ret;
+}
+
+void TreeArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"count", "fanout"});
+  // Deep
+  b->Args({256, 1});
+  // Wide
+  b->Args({10'000, 10'000});
+  // Balanced
+  b->Args({10'000, 8});
+}
+
+}// namespace
+
+static void BM_Widget_ComputeStyles(benchmark::State& state) {
+  const auto root = MakeTree(state);
+  std::size_t i = 0;
+  for (auto _: state) {
+    root->ComputeStyles(InvalidatingStyles[i++ % InvalidatingStyles.size()]);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Widget_ComputeStyles)->Apply(TreeArgs);
+
+static void BM_Widget_ComputeStyles_Clean(benchmark::State& state) {
+  const auto root = MakeTree(state);
+  root->ComputeStyles(Style {});
+  for (auto _: state) {
+    root->ComputeStyles(Style {});
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Widget_ComputeStyles_Clean)->Apply(TreeArgs);
+
+static void BM_Widget_CalculateLayout(benchmark::State& state) {
+  const auto root = MakeTree(state);
+  root->ComputeStyles(Style {});
+  const auto yoga = root->GetLayoutNode();
+  // Alternate widths, as yoga caches layout for unchanged constraints
+  constexpr std::array widths {800.0f, 801.0f};
+  std::size_t i = 0;
+  for (auto _: state) {
+    YGNodeCalculateLayout(
+      yoga, widths[i++ % widths.size()], YGUndefined, YGDirectionLTR);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Widget_CalculateLayout)->Apply(TreeArgs);
+
+static void BM_Widget_GetMinimumWidth(benchmark::State& state) {
+  const auto root = MakeTree(state);
+  root->ComputeStyles(Style {});
+  const auto yoga = root->GetLayoutNode();
+  for (auto _: state) {
+    benchmark::DoNotOptimize(GetMinimumWidth(yoga));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Widget_GetMinimumWidth)
+  ->ArgNames({"count", "fanout"})
+  ->Args({64, 1})
+  ->Args({1'000, 1'000})
+  ->Args({1'000, 8});
+
+static void BM_TextBlock_Measure(benchmark::State& state) {
+  const auto text = std::make_unique<Widgets::TextBlock>(GetWindow());
+  text->ComputeStyles(Style().Font(SystemFont::Resolve(SystemFont::Body)));
+  const auto yoga = text->GetLayoutNode();
+
+  // Alternate the text so that each iteration needs a new measurement
+  const auto length = static_cast<std::size_t>(state.range(0));
+  const std::array strings {
+    MakeText(length, "lorem ipsum "),
+    MakeText(length, "dolor sit amet "),
+  };
+  std::size_t i = 0;
+  for (auto _: state) {
+    text->SetText(strings[i++ % strings.size()]);
+    YGNodeCalculateLayout(yoga, 200, YGUndefined, YGDirectionLTR);
+    benchmark::DoNotOptimize(YGNodeLayoutGetHeight(yoga));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TextBlock_Measure)->Arg(16)->Arg(256)->Arg(4096);
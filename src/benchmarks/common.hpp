@@ -0,0 +1,21 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FredEmmott/GUI/OffscreenWindow.hpp>
+
+namespace FredEmmott::GUI::benchmarks {
+
+/** A headless window shared by all benchmarks in the process.
+ *
+ * Widgets require an owner window, and creating the first `OffscreenWindow`
+ * also sets up the Skia font metrics provider used for text measurement.
+ */
+inline OffscreenWindow* GetWindow() {
+  static OffscreenWindow ret {
+    OffscreenWindowOptions {.mCanvasSize = {1280, 720}},
+  };
+  return &ret;
+}
+
+}// namespace FredEmmott::GUI::benchmarks
@@ -237,6 +237,12 @@ static void demo_input() {
     if (fuii::TextBox(&textBoxValue).Caption("TextBox()")) {
       std::println(stderr, "TextBox value is {}", textBoxValue);
     }
+
+    static std::string multiLineValue {
+      "This text box accepts newlines.\nLong lines are wrapped at word "
+      "boundaries to fit the width of the text box."};
+    std::ignore
+      = fuii::MultiLineTextBox(&multiLineValue).Caption("MultiLineTextBox()");
   }
 
   {
@@ -356,6 +362,16 @@ static void demo_popups() {
   }
 }
 
+static void demo_lists() {
+  const auto page = BeginDemoPage().Scoped();
+  fuii::Label("ListView() with 1,000,000 items").Subtitle();
+  // Only the visible items (plus a margin) are realized
+  fuii::ListView(1'000'000, fuii::ItemSizing::Fixed, 32, [](const auto i) {
+    // A fixed ID, so that the label is recycled instead of recreated
+    fuii::Label(std::format("Item #{}", i), fuii::ID {"label"});
+  });
+}
+
 static void demo_about() {
   const auto page = BeginDemoPage().Scoped();
   const auto card = BeginDemoCard().Scoped();
@@ -384,6 +400,7 @@ static void AppTick(fui::Window&) {
     Selections,
     Input,
     Popups,
+    Lists,
 #ifdef _WIN32
     Win32,
 #endif
@@ -435,6 +452,12 @@ static void AppTick(fui::Window&) {
     demo_popups();
   }
 
+  if (
+    const auto page
+    = fuii::BeginNavigationViewItem(Page::Lists, "\ue8fd", "Lists").Scoped()) {
+    demo_lists();
+  }
+
 #ifdef _WIN32
   // Glyph is "OEM"
   if (
@@ -16,7 +16,9 @@ add_library(
   FredEmmott/GUI/FocusManager.cpp FredEmmott/GUI/FocusManager.hpp
   FredEmmott/GUI/Font.cpp FredEmmott/GUI/Font.hpp
   FredEmmott/GUI/FontWeight.hpp
+  FredEmmott/GUI/FrameProfiler.cpp FredEmmott/GUI/FrameProfiler.hpp
   FredEmmott/GUI/FrameRateRequirement.hpp
+  FredEmmott/GUI/FrameScheduler.cpp FredEmmott/GUI/FrameScheduler.hpp
   FredEmmott/GUI/IconProvider.cpp
   FredEmmott/GUI/IconProvider.hpp
   FredEmmott/GUI/Immediate/Button.cpp FredEmmott/GUI/Immediate/Button.hpp
@@ -32,6 +34,7 @@ add_library(
   FredEmmott/GUI/Immediate/GPUTexture.cpp
   FredEmmott/GUI/Immediate/GPUTexture.hpp
   FredEmmott/GUI/Immediate/ID.hpp
+  FredEmmott/GUI/Immediate/ItemsRepeater.cpp FredEmmott/GUI/Immediate/ItemsRepeater.hpp
   FredEmmott/GUI/Immediate/HyperlinkButton.cpp FredEmmott/GUI/Immediate/HyperlinkButton.hpp
   FredEmmott/GUI/Immediate/Label.cpp FredEmmott/GUI/Immediate/Label.hpp
   FredEmmott/GUI/Immediate/MenuFlyout.cpp
@@ -72,6 +75,7 @@ add_library(
   FredEmmott/GUI/PseudoClasses.cpp FredEmmott/GUI/PseudoClasses.hpp
   FredEmmott/GUI/Rect.hpp
   FredEmmott/GUI/Renderer.hpp
+  FredEmmott/GUI/ShapedText.hpp
   FredEmmott/GUI/Size.hpp
   FredEmmott/GUI/SoftwareBitmap.hpp
   FredEmmott/GUI/SolidColorBrush.hpp
@@ -101,6 +105,7 @@ add_library(
   FredEmmott/GUI/StaticTheme/detail/ToolTip.handwritten.cpp
   FredEmmott/GUI/StaticTheme/detail/ToolTip.handwritten.hpp
   FredEmmott/GUI/Style.cpp FredEmmott/GUI/Style.hpp
+  FredEmmott/GUI/StyleCache.cpp FredEmmott/GUI/StyleCache.hpp
   FredEmmott/GUI/StyleClass.cpp FredEmmott/GUI/StyleClass.hpp
   FredEmmott/GUI/StyleProperty.hpp
   FredEmmott/GUI/StylePropertyTypes.hpp
@@ -111,6 +116,7 @@ add_library(
   FredEmmott/GUI/SystemFont.cpp FredEmmott/GUI/SystemFont.hpp
   FredEmmott/GUI/SystemSettings.cpp FredEmmott/GUI/SystemSettings.hpp
   FredEmmott/GUI/SystemTheme.cpp FredEmmott/GUI/SystemTheme.hpp
+  FredEmmott/GUI/TransitionEngine.cpp FredEmmott/GUI/TransitionEngine.hpp
   FredEmmott/GUI/WidgetFont.cpp FredEmmott/GUI/WidgetFont.hpp
   FredEmmott/GUI/Widgets/Button.cpp FredEmmott/GUI/Widgets/Button.hpp
   FredEmmott/GUI/Widgets/Card.cpp FredEmmott/GUI/Widgets/Card.hpp
@@ -121,6 +127,7 @@ add_library(
   FredEmmott/GUI/Widgets/GPUTexture.cpp
   FredEmmott/GUI/Widgets/GPUTexture.hpp
   FredEmmott/GUI/Widgets/HyperlinkButton.cpp FredEmmott/GUI/Widgets/HyperlinkButton.hpp
+  FredEmmott/GUI/Widgets/ItemsRepeater.cpp FredEmmott/GUI/Widgets/ItemsRepeater.hpp
   FredEmmott/GUI/Widgets/Label.cpp
   FredEmmott/GUI/Widgets/Label.hpp
   FredEmmott/GUI/Widgets/MenuFlyoutItem.cpp
@@ -175,10 +182,13 @@ add_library(
   FredEmmott/GUI/detail/AutomationActivityFlag.hpp
   FredEmmott/GUI/detail/SelectionPill.cpp
   FredEmmott/GUI/detail/SelectionPill.hpp
+  FredEmmott/GUI/detail/TextLineLayout.cpp FredEmmott/GUI/detail/TextLineLayout.hpp
+  FredEmmott/GUI/detail/Utf16Index.cpp FredEmmott/GUI/detail/Utf16Index.hpp
   FredEmmott/GUI/detail/font_detail.hpp
   FredEmmott/GUI/detail/icu.hpp
   FredEmmott/GUI/detail/immediate/CaptionResultMixin.cpp
   FredEmmott/GUI/detail/immediate/CaptionResultMixin.hpp
+  FredEmmott/GUI/detail/immediate/PaintCachedResultMixin.hpp
   FredEmmott/GUI/detail/immediate/ScopeableResultMixin.hpp
   FredEmmott/GUI/detail/immediate/SelectionManager.hpp
   FredEmmott/GUI/detail/immediate/StyledResultMixin.hpp
@@ -215,15 +225,18 @@ add_library(
   FredEmmott/utility/almost_equal.hpp
   FredEmmott/utility/bitflag_enums.hpp
   FredEmmott/utility/drop_last_t.hpp
+  FredEmmott/utility/flat_enum_map.hpp
   FredEmmott/utility/unordered_map.hpp
 )
 set(
   SKIA_SOURCES
   FredEmmott/GUI/Brush_Skia.cpp
   FredEmmott/GUI/LinearGradientBrush_Skia.cpp
+  FredEmmott/GUI/OffscreenWindow.cpp FredEmmott/GUI/OffscreenWindow.hpp
   FredEmmott/GUI/SkiaRenderer.cpp FredEmmott/GUI/SkiaRenderer.hpp
   FredEmmott/GUI/SystemFont_Skia.cpp
   FredEmmott/GUI/Widgets/TextBlock_Skia.cpp
+  FredEmmott/GUI/detail/skia_detail.cpp FredEmmott/GUI/detail/skia_detail.hpp
   FredEmmott/GUI/Windows/Win32Direct3D12GaneshWindow.cpp FredEmmott/GUI/Windows/Win32Direct3D12GaneshWindow.hpp
 )
 set(